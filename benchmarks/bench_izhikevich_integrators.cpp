@@ -0,0 +1,115 @@
+/**
+ * @file bench_izhikevich_integrators.cpp
+ * @brief Accuracy versus cost of the Izhikevich integrators.
+ * @author Dario Romandini
+ *
+ * Simulates a population of regular-spiking neurons driven by a range of
+ * constant input currents with every integrator and substep count, and
+ * compares spike counts and first-spike times against an RK4 run with a
+ * 0.0025 ms substep. Prints one row per configuration:
+ *
+ *     bench_izhikevich_integrators [neurons] [duration_ms] [dt_ms]
+ */
+
+#include "NeuronKernels.h"
+#include "NeuronPopulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+/** @brief Spike statistics of one run. */
+struct Run
+{
+    std::vector<int> counts;         ///< Spikes per neuron
+    std::vector<double> firstSpike;  ///< Time of the first spike (ms), -1 if none
+    double seconds = 0.0;            ///< Wall-clock time of the update loop
+};
+
+Run simulate(std::size_t n, double duration, double dt, IzhikevichIntegrator integrator,
+             int substeps)
+{
+    NeuronPopulation pop(NeuronPopulation::Model::Izhikevich, n);
+    pop.setIzhikevichIntegrator(integrator, substeps);
+
+    Run run;
+    run.counts.assign(n, 0);
+    run.firstSpike.assign(n, -1.0);
+    const int steps = static_cast<int>(std::lround(duration / dt));
+    std::vector<int> fired;
+    std::chrono::duration<double> elapsed{0.0};
+
+    for (int s = 0; s < steps; ++s) {
+        for (std::size_t i = 0; i < n; ++i) {
+            pop.setInputCurrent(i, 15.0 * static_cast<double>(i) / static_cast<double>(n));
+        }
+        fired.clear();
+        auto start = std::chrono::steady_clock::now();
+        pop.update(dt, 0.0, 0, n, &fired);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        for (int i : fired) {
+            if (run.counts[i]++ == 0) run.firstSpike[i] = (s + 1) * dt;
+        }
+    }
+    run.seconds = elapsed.count();
+    return run;
+}
+
+const char* name(IzhikevichIntegrator integrator)
+{
+    switch (integrator) {
+    case IzhikevichIntegrator::Euler: return "euler";
+    case IzhikevichIntegrator::ExponentialEuler: return "exp-euler";
+    case IzhikevichIntegrator::RK2: return "rk2";
+    case IzhikevichIntegrator::RK4: return "rk4";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const double duration = argc > 2 ? std::atof(argv[2]) : 1000.0;
+    const double dt = argc > 3 ? std::atof(argv[3]) : 0.5;
+    const int referenceSubsteps = std::max(1, static_cast<int>(std::lround(dt / 0.0025)));
+
+    std::printf("kernels %s, %zu neurons, %.0f ms, dt %.3g ms\n",
+                NeuronKernels::active().name, n, duration, dt);
+    const Run ref = simulate(n, duration, dt, IzhikevichIntegrator::RK4, referenceSubsteps);
+
+    std::printf("%-10s %8s %14s %18s %16s\n",
+                "integrator", "substeps", "ns/neuron-step", "rate error (%)", "t0 error (ms)");
+    for (int m = 0; m < izhikevichIntegratorCount; ++m) {
+        const auto integrator = static_cast<IzhikevichIntegrator>(m);
+        for (int substeps : {1, 2, 4, 8}) {
+            const Run run = simulate(n, duration, dt, integrator, substeps);
+
+            double rateError = 0.0, timeError = 0.0;
+            std::size_t spiking = 0, timed = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (ref.counts[i] > 0) {
+                    rateError += std::abs(run.counts[i] - ref.counts[i]) /
+                                 static_cast<double>(ref.counts[i]);
+                    ++spiking;
+                }
+                if (ref.firstSpike[i] >= 0.0 && run.firstSpike[i] >= 0.0) {
+                    timeError += std::abs(run.firstSpike[i] - ref.firstSpike[i]);
+                    ++timed;
+                }
+            }
+            const double steps = duration / dt;
+            std::printf("%-10s %8d %14.2f %18.3f %16.3f\n", name(integrator), substeps,
+                        1e9 * run.seconds / (steps * static_cast<double>(n)),
+                        spiking ? 100.0 * rateError / static_cast<double>(spiking) : 0.0,
+                        timed ? timeError / static_cast<double>(timed) : 0.0);
+        }
+    }
+    return 0;
+}
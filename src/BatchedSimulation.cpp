@@ -0,0 +1,126 @@
+/**
+ * @file BatchedSimulation.cpp
+ * @brief Implements lockstep replica updates and batched spike delivery.
+ * @author Dario Romandini
+ */
+
+#include "BatchedSimulation.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const Simulation& singlePopulation(const Simulation& prototype)
+{
+    if (prototype.populationCount() != 1) {
+        throw std::invalid_argument("BatchedSimulation needs a prototype with one population");
+    }
+    return prototype;
+}
+
+} // namespace
+
+BatchedSimulation::BatchedSimulation(const Simulation& prototype, int batch)
+    : batch_(std::max(batch, 1)), neurons_(singlePopulation(prototype).neuronCount()),
+      dt_(prototype.dt()), inputCurrent_(prototype.inputCurrent()),
+      population_(prototype.population().model(), static_cast<std::size_t>(neurons_) * batch_,
+                  prototype.precision()),
+      connectivity_(prototype.sharedConnectivity()),
+      replicaInput_(batch_, 0.0),
+      replicaFired_(batch_),
+      spikes_(batch_)
+{
+    const NeuronPopulation& proto = prototype.population();
+    for (int n = 0; n < neurons_; ++n) {
+        const std::vector<double> params = proto.params(n);
+        for (int b = 0; b < batch_; ++b) {
+            population_.setParams(static_cast<std::size_t>(n) * batch_ + b, params);
+        }
+    }
+    population_.setKernels(proto.kernels());
+    population_.setIntegrator(proto.integrator(), proto.substeps());
+    population_.setDelaySlots(connectivity_->maxDelay());
+}
+
+void BatchedSimulation::setNoise(double sigma, std::uint64_t seed)
+{
+    noiseSigma_ = sigma;
+    noise_.clear();
+    for (int b = 0; b < batch_; ++b) {
+        noise_.emplace_back(seed, static_cast<std::uint64_t>(b));
+    }
+}
+
+void BatchedSimulation::step()
+{
+    const bool perReplica = noiseSigma_ != 0.0 ||
+        std::any_of(replicaInput_.begin(), replicaInput_.end(), [](double i) { return i != 0.0; });
+    if (perReplica) {
+        for (int n = 0; n < neurons_; ++n) {
+            for (int b = 0; b < batch_; ++b) {
+                double input = replicaInput_[b];
+                if (noiseSigma_ != 0.0) input += noiseSigma_ * noise_[b].normal();
+                population_.setInputCurrent(static_cast<std::size_t>(n) * batch_ + b, input);
+            }
+        }
+    }
+
+    fired_.clear();
+    population_.update(dt_, inputCurrent_, 0, population_.size(), &fired_);
+    deliver();
+    population_.advanceDelaySlot();
+
+    for (auto& fired : replicaFired_) fired.clear();
+    for (int e : fired_) {
+        replicaFired_[e % batch_].push_back(e / batch_);
+    }
+    for (int b = 0; b < batch_; ++b) {
+        spikes_[b].record(step_, replicaFired_[b]);
+    }
+    ++step_;
+}
+
+void BatchedSimulation::run(int steps)
+{
+    for (int s = 0; s < steps; ++s) step();
+}
+
+void BatchedSimulation::deliver()
+{
+    if (population_.precision() == NeuronPopulation::Precision::Float) {
+        deliverTo(population_.synapticInputData<float>());
+    } else {
+        deliverTo(population_.synapticInputData<double>());
+    }
+}
+
+template <typename T>
+void BatchedSimulation::deliverTo(T* ring)
+{
+    const SynapseMatrix& m = *connectivity_;
+    const std::size_t n = population_.size();
+    const std::size_t slots = population_.delaySlots();
+    const std::size_t slot = population_.delaySlot();
+
+    // fired_ is sorted, so the replicas that fired for one source are adjacent:
+    // each synapse is read once and applied to all of them.
+    for (std::size_t f = 0; f < fired_.size();) {
+        const int src = fired_[f] / batch_;
+        std::size_t last = f;
+        while (last < fired_.size() && fired_[last] / batch_ == src) ++last;
+
+        auto add = [&](int dst, double weight, int delay) {
+            std::size_t s = slot + static_cast<std::size_t>(delay);
+            if (s >= slots) s -= slots;
+            T* target = ring + s * n + static_cast<std::size_t>(dst) * batch_;
+            const T w = static_cast<T>(weight);
+            for (std::size_t j = f; j < last; ++j) {
+                target[fired_[j] % batch_] += w;
+            }
+        };
+        m.forEachProcedural(src, 0, neurons_, add);
+        m.forEachWeighted(src, [&](std::size_t k, int dst, double weight) { add(dst, weight, m.delay(k)); });
+        f = last;
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * @file BatchedSimulation.h
+ * @brief Lockstep simulation of many replicas of one network.
+ * @author Dario Romandini
+ */
+
+#ifndef BATCHED_SIMULATION_H
+#define BATCHED_SIMULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "NeuronPopulation.h"
+#include "Random.h"
+#include "SpikeStore.h"
+#include "SynapseMatrix.h"
+
+class Simulation;
+
+/**
+ * @class BatchedSimulation
+ * @brief B independent replicas of a network advanced by one kernel call per step.
+ *
+ * All replicas share the connectivity of a prototype Simulation but have
+ * their own state, input and noise. State is laid out [neuron][replica], so
+ * entry n·B + b of the underlying population is neuron n of replica b: the
+ * vectorized kernels advance all replicas together, and every synapse read
+ * during delivery serves all replicas whose source fired.
+ *
+ * Without noise and per-replica input, each replica evolves bit-identically
+ * to the prototype stepped on its own.
+ */
+class BatchedSimulation
+{
+public:
+    /**
+     * @brief Construct replicas of a prototype, starting from the model's initial state.
+     * @param prototype Simulation providing grid, dt, model, parameters, precision,
+     *        connectivity and input current.
+     * @param batch Number of replicas B.
+     * @throws std::invalid_argument if the prototype has several populations.
+     */
+    BatchedSimulation(const Simulation& prototype, int batch);
+
+    /** @return Number of replicas. */
+    int batch() const { return batch_; }
+
+    /** @return Number of neurons per replica. */
+    int neuronCount() const { return neurons_; }
+
+    /** @brief Set the input current shared by all replicas (nA). */
+    void setInputCurrent(double current) { inputCurrent_ = current; }
+
+    /**
+     * @brief Set an additional constant input for one replica (nA).
+     * @throws std::out_of_range if @p replica is not in [0, batch()).
+     */
+    void setReplicaInput(int replica, double current) { replicaInput_.at(replica) = current; }
+
+    /**
+     * @brief Add independent Gaussian input noise to every neuron of every replica.
+     * @param sigma Standard deviation per step (nA); 0 disables noise.
+     * @param seed Seed; replica b draws from stream b, so replicas are independent.
+     */
+    void setNoise(double sigma, std::uint64_t seed);
+
+    /** @brief Advance all replicas by one step. */
+    void step();
+
+    /**
+     * @brief Advance all replicas by several steps.
+     * @param steps Number of steps.
+     */
+    void run(int steps);
+
+    /** @return Number of steps simulated so far. */
+    std::uint32_t currentStep() const { return step_; }
+
+    /**
+     * @return Membrane potential of neuron @p idx in replica @p replica (mV).
+     * @throws std::out_of_range if the replica or the neuron does not exist.
+     */
+    double voltage(int replica, int idx) const
+    {
+        if (replica < 0 || replica >= batch_ || idx < 0 || idx >= neurons_) {
+            throw std::out_of_range("no neuron " + std::to_string(idx) + " in replica " +
+                                    std::to_string(replica));
+        }
+        return population_.voltage(static_cast<std::size_t>(idx) * batch_ + replica);
+    }
+
+    /**
+     * @return Spike history of one replica.
+     * @throws std::out_of_range if @p replica is not in [0, batch()).
+     */
+    const SpikeStore& spikeStore(int replica) const { return spikes_.at(replica); }
+
+    /** @return Population holding all replicas, [neuron][replica] layout. */
+    const NeuronPopulation& population() const { return population_; }
+
+private:
+    int batch_;
+    int neurons_;
+    double dt_;
+    std::uint32_t step_ = 0;
+    double inputCurrent_;
+
+    NeuronPopulation population_;
+    std::shared_ptr<const SynapseMatrix> connectivity_;
+
+    std::vector<double> replicaInput_;   ///< Constant extra input per replica
+    double noiseSigma_ = 0.0;
+    std::vector<RandomStream> noise_;    ///< One stream per replica
+
+    std::vector<int> fired_;                  ///< Fired entries (n·B + b), ascending
+    std::vector<std::vector<int>> replicaFired_;  ///< Fired neurons per replica
+    std::vector<SpikeStore> spikes_;          ///< Spike history per replica
+
+    /** @brief Deliver the spikes of fired_ through the shared rows. */
+    void deliver();
+
+    /** @brief deliver() into the synaptic input ring of scalar type T. */
+    template <typename T>
+    void deliverTo(T* ring);
+};
+
+#endif // BATCHED_SIMULATION_H
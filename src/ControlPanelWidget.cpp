@@ -11,6 +11,8 @@
 #include <QComboBox>
 #include <QHBoxLayout>
 #include <QFormLayout>
+#include <algorithm>
+#include <thread>
 
 ControlPanelWidget::ControlPanelWidget(QWidget* parent)
     : QWidget(parent), running_(false)
@@ -18,24 +20,31 @@ ControlPanelWidget::ControlPanelWidget(QWidget* parent)
     startStopButton_    = new QPushButton(tr("Start"), this);
     gridXSpin_          = new QSpinBox(this);
     gridYSpin_          = new QSpinBox(this);
+    networkCombo_       = new QComboBox(this);
     currentSlider_      = new QSlider(Qt::Horizontal, this);
     displayModeCombo_   = new QComboBox(this);
     neuronSelectCombo_  = new QComboBox(this);
+    threadsSpin_        = new QSpinBox(this);
 
     gridXSpin_->setRange(1, 100);
     gridYSpin_->setRange(1, 100);
     gridXSpin_->setValue(10);
     gridYSpin_->setValue(10);
+    networkCombo_->addItems({tr("LIF"), tr("Izhikevich RS"), tr("Izhikevich RS + FS (80/20)")});
     currentSlider_->setRange(0, 100);
     displayModeCombo_->addItems({tr("Voltage"), tr("Spike Rate"), tr("Amplitude")});
     neuronSelectCombo_->addItem(tr("All"));
+    threadsSpin_->setRange(1, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    threadsSpin_->setValue(1);
 
     auto form = new QFormLayout;
     form->addRow(tr("Grid X:"), gridXSpin_);
     form->addRow(tr("Grid Y:"), gridYSpin_);
+    form->addRow(tr("Network:"), networkCombo_);
     form->addRow(tr("Current (nA):"), currentSlider_);
     form->addRow(tr("Display Mode:"), displayModeCombo_);
     form->addRow(tr("Neuron:"), neuronSelectCombo_);
+    form->addRow(tr("Threads:"), threadsSpin_);
 
     auto mainLayout = new QHBoxLayout;
     mainLayout->addWidget(startStopButton_);
@@ -45,9 +54,11 @@ ControlPanelWidget::ControlPanelWidget(QWidget* parent)
     connect(startStopButton_, &QPushButton::clicked, this, &ControlPanelWidget::handleStartStop);
     connect(gridXSpin_, qOverload<int>(&QSpinBox::valueChanged), this, &ControlPanelWidget::handleGridXChanged);
     connect(gridYSpin_, qOverload<int>(&QSpinBox::valueChanged), this, &ControlPanelWidget::handleGridYChanged);
+    connect(networkCombo_, qOverload<int>(&QComboBox::currentIndexChanged), this, &ControlPanelWidget::handleNetworkChanged);
     connect(currentSlider_, &QSlider::valueChanged, this, &ControlPanelWidget::handleCurrentChanged);
     connect(displayModeCombo_, qOverload<int>(&QComboBox::currentIndexChanged), this, &ControlPanelWidget::handleModeChanged);
     connect(neuronSelectCombo_, qOverload<int>(&QComboBox::currentIndexChanged), this, &ControlPanelWidget::handleNeuronSelection);
+    connect(threadsSpin_, qOverload<int>(&QSpinBox::valueChanged), this, &ControlPanelWidget::handleThreadsChanged);
 }
 
 void ControlPanelWidget::handleStartStop()
@@ -67,6 +78,11 @@ void ControlPanelWidget::handleGridYChanged(int y)
     emit gridSizeChanged(gridXSpin_->value(), y);
 }
 
+void ControlPanelWidget::handleNetworkChanged(int idx)
+{
+    emit networkChanged(idx);
+}
+
 void ControlPanelWidget::handleCurrentChanged(int val)
 {
     emit inputCurrentChanged(static_cast<double>(val));
@@ -81,3 +97,8 @@ void ControlPanelWidget::handleNeuronSelection(int idx)
 {
     emit neuronSelected(idx);
 }
+
+void ControlPanelWidget::handleThreadsChanged(int threads)
+{
+    emit threadCountChanged(threads);
+}
@@ -17,7 +17,7 @@ class QComboBox;
 /**
  * @class ControlPanelWidget
  * @brief A widget providing controls for starting/stopping the simulation,
- * adjusting grid size, input current, display mode, and selecting neurons.
+ * adjusting grid size, network, input current, display mode, worker threads, and selecting neurons.
  */
 class ControlPanelWidget : public QWidget
 {
@@ -34,25 +34,31 @@ signals:
     void startSimulation();
     void stopSimulation();
     void gridSizeChanged(int nx, int ny);
+    void networkChanged(int networkIndex);
     void inputCurrentChanged(double current);
     void displayModeChanged(int modeIndex);
     void neuronSelected(int neuronIndex);
+    void threadCountChanged(int threads);
 
 private slots:
     void handleStartStop();
     void handleGridXChanged(int value);
     void handleGridYChanged(int value);
+    void handleNetworkChanged(int index);
     void handleCurrentChanged(int value);
     void handleModeChanged(int index);
     void handleNeuronSelection(int index);
+    void handleThreadsChanged(int value);
 
 private:
     QPushButton*   startStopButton_;
     QSpinBox*      gridXSpin_;
     QSpinBox*      gridYSpin_;
+    QComboBox*     networkCombo_;
     QSlider*       currentSlider_;
     QComboBox*     displayModeCombo_;
     QComboBox*     neuronSelectCombo_;
+    QSpinBox*      threadsSpin_;
     bool           running_;
 };
 
@@ -0,0 +1,106 @@
+/**
+ * @file Ensemble.cpp
+ * @brief Implements the concurrent parameter sweep.
+ * @author Dario Romandini
+ */
+
+#include "Ensemble.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+Ensemble::Ensemble(EnsembleConfig config, std::vector<double> inputCurrents,
+                   std::vector<double> weights, std::vector<double> probabilities)
+    : config_(std::move(config))
+{
+    const int N = config_.nx * config_.ny;
+    for (int idx : config_.monitorNeurons) {
+        if (idx < 0 || idx >= N) {
+            throw std::invalid_argument("monitored neuron " + std::to_string(idx) + " out of range [0, " +
+                                        std::to_string(N) + ")");
+        }
+    }
+    for (double p : probabilities) {
+        for (double w : weights) {
+            const std::size_t topology = topologies_.size();
+            topologies_.emplace_back(p, w);
+            for (double input : inputCurrents) {
+                members_.push_back({input, w, p});
+                topology_.push_back(topology);
+            }
+        }
+    }
+}
+
+EnsembleResult Ensemble::run(int threads) const
+{
+    ThreadPool pool(threads);
+    const int N = config_.nx * config_.ny;
+    const int steps = static_cast<int>(std::lround(config_.duration / config_.dt));
+    const std::size_t width = config_.monitorNeurons.size();
+    const int interval = std::max(config_.monitorInterval, 1);
+    const std::size_t samples = (steps + interval - 1) / interval;
+
+    // Calls task(i) for i in [0, count), each worker pulling the next index.
+    auto forEachTask = [&](std::size_t count, auto&& task) {
+        std::atomic<std::size_t> next{0};
+        pool.run([&](int) {
+            for (std::size_t i; (i = next.fetch_add(1)) < count;) task(i);
+        });
+    };
+
+    // Build each distinct connectivity once.
+    std::vector<std::shared_ptr<const SynapseMatrix>> matrices(topologies_.size());
+    forEachTask(topologies_.size(), [&](std::size_t t) {
+        Simulation sim(config_.nx, config_.ny, config_.dt, 1);
+        sim.connectRandom(topologies_[t].first, topologies_[t].second, config_.delay, config_.seed);
+        matrices[t] = sim.sharedConnectivity();
+    });
+
+    EnsembleResult result;
+    result.samples = width > 0 ? samples : 0;
+    result.spikeCounts.assign(size(), 0);
+    result.meanRates.assign(size(), 0.0);
+    result.rates.assign(size() * N, 0.0);
+    result.traces.assign(size() * result.samples * width, 0.0);
+
+    forEachTask(size(), [&](std::size_t i) {
+        Simulation sim(config_.nx, config_.ny, config_.dt, 1, config_.precision);
+        sim.setLifIntegrator(config_.integrator);
+        sim.setConnectivity(matrices[topology_[i]]);
+        sim.setInputCurrent(members_[i].inputCurrent);
+        std::shared_ptr<StateMonitor> monitor;
+        if (width > 0) {
+            monitor = sim.addStateMonitor(config_.monitorNeurons, StateMonitor::Variable::Voltage,
+                                          interval, samples);
+        }
+        sim.run(steps);
+
+        const double seconds = steps * config_.dt / 1000.0;
+        double* rates = result.rates.data() + i * N;
+        std::uint64_t total = 0;
+        sim.spikeStore().forEach(0, sim.currentStep(), [&](const SpikeEvent& ev) {
+            rates[ev.neuron] += 1.0;
+            ++total;
+        });
+        result.spikeCounts[i] = total;
+        if (steps > 0 && N > 0) {
+            for (int n = 0; n < N; ++n) rates[n] /= seconds;
+            result.meanRates[i] = total / (N * seconds);
+        }
+
+        if (monitor) {
+            double* out = result.traces.data() + i * result.samples * width;
+            for (std::size_t k = 0; k < monitor->size(); ++k, out += width) {
+                std::copy(monitor->sample(k), monitor->sample(k) + width, out);
+            }
+        }
+    });
+    return result;
+}
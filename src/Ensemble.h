@@ -0,0 +1,105 @@
+/**
+ * @file Ensemble.h
+ * @brief Runs a grid of simulation variants concurrently and summarizes them.
+ * @author Dario Romandini
+ */
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "NeuronPopulation.h"
+
+/**
+ * @struct EnsembleConfig
+ * @brief Settings shared by every member of an ensemble.
+ */
+struct EnsembleConfig
+{
+    int nx = 10;                      ///< Grid width
+    int ny = 10;                      ///< Grid height
+    double dt = 0.1;                  ///< Integration step (ms)
+    double duration = 1000.0;         ///< Simulated time per member (ms)
+    double delay = 0.0;               ///< Synaptic delay (ms)
+    std::uint64_t seed = 1;           ///< Seed of the random connectivity
+    std::vector<int> monitorNeurons;  ///< Neurons whose voltage is recorded (may be empty)
+    int monitorInterval = 10;         ///< Voltage sampling interval (steps)
+    NeuronPopulation::Precision precision = NeuronPopulation::Precision::Double;  ///< Neuron state type
+    LifIntegrator integrator = LifIntegrator::Euler;  ///< Integration scheme of the neurons
+};
+
+/**
+ * @struct EnsembleMember
+ * @brief Parameters of one ensemble member.
+ */
+struct EnsembleMember
+{
+    double inputCurrent;  ///< Uniform external input (nA)
+    double weight;        ///< Synaptic weight (nA)
+    double probability;   ///< Connection probability of connectRandom()
+};
+
+/**
+ * @struct EnsembleResult
+ * @brief Summary statistics of every member, in member order.
+ */
+struct EnsembleResult
+{
+    std::vector<std::uint64_t> spikeCounts;  ///< Total spikes per member
+    std::vector<double> meanRates;           ///< Mean firing rate per member (Hz)
+    std::vector<double> rates;               ///< Per-neuron rates (Hz), members × neurons
+    std::vector<double> traces;              ///< Voltages, members × samples × monitored neurons
+    std::size_t samples = 0;                 ///< Voltage samples per member
+};
+
+/**
+ * @class Ensemble
+ * @brief A parameter sweep over input current, weight and connection probability.
+ *
+ * Members are the Cartesian product of the three parameter lists, with the
+ * probability varying slowest and the input current fastest. run() simulates
+ * them concurrently, one single-threaded Simulation per worker at a time,
+ * with workers pulling the next member from a shared counter so that uneven
+ * members balance out. Members with the same (probability, weight) share one
+ * immutable connectivity matrix, built once.
+ */
+class Ensemble
+{
+public:
+    /**
+     * @brief Construct the ensemble; nothing is simulated yet.
+     * @param config Settings shared by all members.
+     * @param inputCurrents Input currents to sweep (nA).
+     * @param weights Synaptic weights to sweep (nA).
+     * @param probabilities Connection probabilities to sweep.
+     * @throws std::invalid_argument if a monitored neuron is outside the nx × ny grid.
+     */
+    Ensemble(EnsembleConfig config, std::vector<double> inputCurrents,
+             std::vector<double> weights, std::vector<double> probabilities);
+
+    /** @return Number of members. */
+    std::size_t size() const { return members_.size(); }
+
+    /** @return Parameters of member @p i. */
+    const EnsembleMember& member(std::size_t i) const { return members_[i]; }
+
+    /** @return Settings shared by all members. */
+    const EnsembleConfig& config() const { return config_; }
+
+    /**
+     * @brief Simulate every member and collect the summaries.
+     * @param threads Concurrent members; 0 uses all hardware threads.
+     * @return Results, identical for any thread count.
+     */
+    EnsembleResult run(int threads = 0) const;
+
+private:
+    EnsembleConfig config_;
+    std::vector<EnsembleMember> members_;
+    std::vector<std::size_t> topology_;  ///< Connectivity index of each member
+    std::vector<std::pair<double, double>> topologies_;  ///< Distinct (probability, weight)
+};
+
+#endif // ENSEMBLE_H
@@ -66,9 +66,14 @@ void HeatmapWidget::drawHeatmap(QPainter& p)
     double cellW = sz.width() * zoom_ / nx;
     double cellH = sz.height() * zoom_ / ny;
 
-    std::vector<double> vals(N);
-    for (int i = 0; i < N; ++i) {
-        vals[i] = computeValue(i);
+    std::vector<double> vals;
+    if (mode_ == SpikeRate) {
+        vals = simulation_->getSpikeRates(100);
+    } else {
+        vals.resize(N);
+        for (int i = 0; i < N; ++i) {
+            vals[i] = computeValue(i);
+        }
     }
 
     double minV, maxV;
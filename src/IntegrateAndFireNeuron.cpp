@@ -7,51 +7,45 @@
 #include "IntegrateAndFireNeuron.h"
 
 IntegrateAndFireNeuron::IntegrateAndFireNeuron(double v_rest, double v_thresh,
-                                               double tau, double reset_v)
-    : v_(v_rest), v_rest_(v_rest), v_thresh_(v_thresh),
-      reset_v_(reset_v), tau_(tau),
-      i_syn_(0.0), i_ext_(0.0),
-      spiked_(false), last_spike_t_(-1e9)
+                                               double tau, double reset_v,
+                                               LifIntegrator integrator)
+    : owned_(std::make_unique<NeuronPopulation>(NeuronPopulation::Model::IntegrateAndFire, 1)),
+      population_(owned_.get()), index_(0)
+{
+    population_->setIntegrateAndFireParams(0, v_rest, v_thresh, tau, reset_v);
+    population_->setLifIntegrator(integrator);
+}
+
+IntegrateAndFireNeuron::IntegrateAndFireNeuron(NeuronPopulation& population, std::size_t index)
+    : population_(&population), index_(index)
 {}
 
 void IntegrateAndFireNeuron::update(double dt)
 {
-    spiked_ = false;
-
-    double input = i_ext_ + i_syn_;
-    v_ += dt * (-(v_ - v_rest_) + input) / tau_;
-
-    if (v_ >= v_thresh_) {
-        spiked_ = true;
-        v_ = reset_v_;
-        last_spike_t_ = 0.0;
-    }
-
-    i_syn_ = 0.0;
-    i_ext_ = 0.0;
+    population_->update(dt, 0.0, index_, index_ + 1);
 }
 
 void IntegrateAndFireNeuron::receiveSynapticCurrent(double i_syn)
 {
-    i_syn_ += i_syn;
+    population_->receiveSynapticCurrent(index_, i_syn);
 }
 
 void IntegrateAndFireNeuron::setInputCurrent(double input)
 {
-    i_ext_ = input;
+    population_->setInputCurrent(index_, input);
 }
 
 bool IntegrateAndFireNeuron::hasSpiked() const
 {
-    return spiked_;
+    return population_->hasSpiked(index_);
 }
 
 double IntegrateAndFireNeuron::lastSpikeTime() const
 {
-    return last_spike_t_;
+    return population_->lastSpikeTime(index_);
 }
 
 double IntegrateAndFireNeuron::getVoltage() const
 {
-    return v_;
+    return population_->voltage(index_);
 }
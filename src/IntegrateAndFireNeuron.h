@@ -8,6 +8,9 @@
 #define INTEGRATE_AND_FIRE_NEURON_H
 
 #include "Neuron.h"
+#include "NeuronPopulation.h"
+#include <cstddef>
+#include <memory>
 
 /**
  * @class IntegrateAndFireNeuron
@@ -15,6 +18,9 @@
  *
  * Models membrane voltage dynamics with an exponential decay toward resting potential,
  * a threshold-based spiking mechanism, and instantaneous voltage reset after a spike.
+ *
+ * The neuron is a view onto one entry of a NeuronPopulation. A standalone neuron
+ * owns a population of size one; Simulation hands out views onto its own storage.
  */
 class IntegrateAndFireNeuron : public Neuron
 {
@@ -25,11 +31,20 @@ public:
      * @param v_thresh Spiking threshold (mV).
      * @param tau Membrane time constant (ms).
      * @param reset_v Voltage to reset to after a spike (mV).
+     * @param integrator Integration scheme (default forward Euler).
      */
     IntegrateAndFireNeuron(double v_rest = -65.0,
                            double v_thresh = -50.0,
                            double tau = 20.0,
-                           double reset_v = -65.0);
+                           double reset_v = -65.0,
+                           LifIntegrator integrator = LifIntegrator::Euler);
+
+    /**
+     * @brief Construct a view onto an existing LIF population entry.
+     * @param population Population holding the neuron state.
+     * @param index Index of the neuron within the population.
+     */
+    IntegrateAndFireNeuron(NeuronPopulation& population, std::size_t index);
 
     /**
      * @brief Update the neuron's state by one time step.
@@ -68,15 +83,9 @@ public:
     void setInputCurrent(double input) override;
 
 private:
-    double v_;             ///< Current membrane voltage
-    double v_rest_;        ///< Resting potential
-    double v_thresh_;      ///< Spiking threshold
-    double reset_v_;       ///< Reset potential after spike
-    double tau_;           ///< Membrane time constant
-    double i_syn_;         ///< Incoming synaptic current
-    double i_ext_;         ///< External input current
-    bool spiked_;          ///< Whether neuron spiked on last step
-    double last_spike_t_;  ///< Time since last spike (not used in time tracking)
+    std::unique_ptr<NeuronPopulation> owned_;  ///< Storage of a standalone neuron
+    NeuronPopulation* population_;             ///< Population holding the state
+    std::size_t index_;                        ///< Index within the population
 };
 
 #endif // INTEGRATE_AND_FIRE_NEURON_H
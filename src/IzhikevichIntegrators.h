@@ -0,0 +1,71 @@
+/**
+ * @file IzhikevichIntegrators.h
+ * @brief One integration substep of the Izhikevich equations for each integrator.
+ * @author Dario Romandini
+ *
+ * Shared by the scalar and the vectorized kernels. V is either the scalar
+ * type T or a vector of T, so both paths perform the same operations in the
+ * same order. The integrator is a template parameter, so the kernels' inner
+ * loops contain no dispatch. Used by IzhikevichModel::update().
+ */
+
+#ifndef IZHIKEVICH_INTEGRATORS_H
+#define IZHIKEVICH_INTEGRATORS_H
+
+#include "NeuronKernels.h"
+#include "NeuronModel.h"
+
+/**
+ * @brief Advance (v, u) by one substep of length h.
+ * @param v Membrane potential (mV).
+ * @param u Recovery variable.
+ * @param a Recovery time constant.
+ * @param b Sensitivity of u to v.
+ * @param input Input current (nA).
+ * @param h Substep length (ms).
+ */
+template <IzhikevichIntegrator M, typename T, typename V>
+inline void izhikevichSubstep(V& v, V& u, const V& a, const V& b, const V& input, T h)
+{
+    auto fv = [&](const V& vv, const V& uu) -> V {
+        return T(0.04) * vv * vv + T(5.0) * vv + T(140.0) - uu + input;
+    };
+    auto fu = [&](const V& vv, const V& uu) -> V { return a * (b * vv - uu); };
+
+    if constexpr (M == IzhikevichIntegrator::Euler) {
+        V dv = fv(v, u);
+        V du = fu(v, u);
+        v += h * dv;
+        u += h * du;
+    } else if constexpr (M == IzhikevichIntegrator::ExponentialEuler) {
+        // v: exponential Euler on the equation linearized at v (Jacobian j).
+        // u: exact decay towards b·v with v frozen over the substep.
+        V j = T(0.08) * v + T(5.0);
+        V jh = j * h;
+        V phi = (jh > T(-1e-6)) & (jh < T(1e-6)) ? h + V{} : (laneExp(jh) - T(1.0)) / j;
+        V target = b * v;
+        v += phi * fv(v, u);
+        u = target + (u - target) * laneExp(V(-a * h));
+    } else if constexpr (M == IzhikevichIntegrator::RK2) {
+        V k1v = fv(v, u);
+        V k1u = fu(v, u);
+        V k2v = fv(v + h * k1v, u + h * k1u);
+        V k2u = fu(v + h * k1v, u + h * k1u);
+        v += T(0.5) * h * (k1v + k2v);
+        u += T(0.5) * h * (k1u + k2u);
+    } else {
+        const T h2 = T(0.5) * h;
+        V k1v = fv(v, u);
+        V k1u = fu(v, u);
+        V k2v = fv(v + h2 * k1v, u + h2 * k1u);
+        V k2u = fu(v + h2 * k1v, u + h2 * k1u);
+        V k3v = fv(v + h2 * k2v, u + h2 * k2u);
+        V k3u = fu(v + h2 * k2v, u + h2 * k2u);
+        V k4v = fv(v + h * k3v, u + h * k3u);
+        V k4u = fu(v + h * k3v, u + h * k3u);
+        v += h / T(6.0) * (k1v + T(2.0) * k2v + T(2.0) * k3v + k4v);
+        u += h / T(6.0) * (k1u + T(2.0) * k2u + T(2.0) * k3u + k4u);
+    }
+}
+
+#endif // IZHIKEVICH_INTEGRATORS_H
@@ -6,57 +6,45 @@
 
 #include "IzhikevichNeuron.h"
 
-IzhikevichNeuron::IzhikevichNeuron(double a, double b, double c, double d)
-    : v_(-65.0), u_(b * -65.0),
-      a_(a), b_(b), c_(c), d_(d),
-      i_syn_(0.0), i_ext_(0.0),
-      spiked_(false), last_spike_t_(-1e9)
+IzhikevichNeuron::IzhikevichNeuron(double a, double b, double c, double d,
+                                   IzhikevichIntegrator integrator, int substeps)
+    : owned_(std::make_unique<NeuronPopulation>(NeuronPopulation::Model::Izhikevich, 1)),
+      population_(owned_.get()), index_(0)
+{
+    population_->setIzhikevichParams(0, a, b, c, d);
+    population_->setIzhikevichIntegrator(integrator, substeps);
+}
+
+IzhikevichNeuron::IzhikevichNeuron(NeuronPopulation& population, std::size_t index)
+    : population_(&population), index_(index)
 {}
 
 void IzhikevichNeuron::update(double dt)
 {
-    spiked_ = false;
-    double input = i_ext_ + i_syn_;
-    i_syn_ = 0.0;
-    i_ext_ = 0.0;
-
-    int steps = static_cast<int>(1.0 / dt);
-    for (int i = 0; i < steps; ++i) {
-        double dv = 0.04 * v_ * v_ + 5.0 * v_ + 140.0 - u_ + input;
-        double du = a_ * (b_ * v_ - u_);
-        v_ += dt * dv;
-        u_ += dt * du;
-
-        if (v_ >= 30.0) {
-            v_ = c_;
-            u_ += d_;
-            spiked_ = true;
-            last_spike_t_ = 0.0;
-        }
-    }
+    population_->update(dt, 0.0, index_, index_ + 1);
 }
 
 void IzhikevichNeuron::receiveSynapticCurrent(double i_syn)
 {
-    i_syn_ += i_syn;
+    population_->receiveSynapticCurrent(index_, i_syn);
 }
 
 void IzhikevichNeuron::setInputCurrent(double input)
 {
-    i_ext_ = input;
+    population_->setInputCurrent(index_, input);
 }
 
 bool IzhikevichNeuron::hasSpiked() const
 {
-    return spiked_;
+    return population_->hasSpiked(index_);
 }
 
 double IzhikevichNeuron::lastSpikeTime() const
 {
-    return last_spike_t_;
+    return population_->lastSpikeTime(index_);
 }
 
 double IzhikevichNeuron::getVoltage() const
 {
-    return v_;
+    return population_->voltage(index_);
 }
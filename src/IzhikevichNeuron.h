@@ -8,6 +8,9 @@
 #define IZHIKEVICH_NEURON_H
 
 #include "Neuron.h"
+#include "NeuronPopulation.h"
+#include <cstddef>
+#include <memory>
 
 /**
  * @class IzhikevichNeuron
@@ -18,7 +21,8 @@
  * various firing patterns by adjusting four parameters: a, b, c, and d.
  *
  * This class conforms to the Neuron interface and can be used
- * interchangeably in simulation components.
+ * interchangeably in simulation components. It is a view onto one entry of a
+ * NeuronPopulation; a standalone neuron owns a population of size one.
  */
 class IzhikevichNeuron : public Neuron
 {
@@ -30,8 +34,19 @@ public:
      * @param b Sensitivity of recovery variable u to membrane voltage (default 0.2).
      * @param c Reset voltage after a spike (mV, default -65.0).
      * @param d Reset increment of u after a spike (default 8.0).
+     * @param integrator Integration scheme (default forward Euler).
+     * @param substeps Integration substeps per update (default 1).
      */
-    IzhikevichNeuron(double a = 0.02, double b = 0.2, double c = -65.0, double d = 8.0);
+    IzhikevichNeuron(double a = 0.02, double b = 0.2, double c = -65.0, double d = 8.0,
+                     IzhikevichIntegrator integrator = IzhikevichIntegrator::Euler,
+                     int substeps = 1);
+
+    /**
+     * @brief Constructs a view onto an existing Izhikevich population entry.
+     * @param population Population holding the neuron state.
+     * @param index Index of the neuron within the population.
+     */
+    IzhikevichNeuron(NeuronPopulation& population, std::size_t index);
 
     /// @copydoc Neuron::update()
     void update(double dt) override;
@@ -52,13 +67,9 @@ public:
     void setInputCurrent(double input) override;
 
 private:
-    double v_;             ///< Membrane potential (mV)
-    double u_;             ///< Recovery variable
-    double a_, b_, c_, d_; ///< Izhikevich model parameters
-    double i_syn_;         ///< Accumulated synaptic input (nA)
-    double i_ext_;         ///< External injected current (nA)
-    bool   spiked_;        ///< Spike flag (true if neuron fired on last update)
-    double last_spike_t_;  ///< Timestamp of last spike (ms)
+    std::unique_ptr<NeuronPopulation> owned_;  ///< Storage of a standalone neuron
+    NeuronPopulation* population_;             ///< Population holding the state
+    std::size_t index_;                        ///< Index within the population
 };
 
 #endif // IZHIKEVICH_NEURON_H
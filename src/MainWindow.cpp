@@ -9,6 +9,7 @@
 #include "HeatmapWidget.h"
 #include "TraceViewWidget.h"
 #include "RasterPlotWidget.h"
+#include "ModelRegistry.h"
 #include "Simulation.h"
 
 #include <QVBoxLayout>
@@ -16,6 +17,32 @@
 #include <QTimer>
 #include <QWidget>
 
+namespace {
+
+/**
+ * @brief Lay out the neurons of @p sim as one of the control panel's network presets.
+ *
+ * The Izhikevich presets use the regular-spiking (RS) and fast-spiking (FS)
+ * parameters of Izhikevich (2003); the E/I network connects 80% excitatory RS
+ * and 20% inhibitory FS neurons at random.
+ */
+void applyNetwork(Simulation& sim, int network)
+{
+    const ModelDescriptor& izhikevich = ModelRegistry::izhikevich();
+    const int n = sim.neuronCount();
+    if (network == 1) {
+        sim.setPopulations({{"rs", &izhikevich, n, {0.02, 0.2, -65.0, 8.0}, 0, 1}});
+    } else if (network == 2) {
+        const int exc = n * 4 / 5;
+        sim.setPopulations({{"exc", &izhikevich, exc, {0.02, 0.2, -65.0, 8.0}, 0, 1},
+                            {"inh", &izhikevich, n - exc, {0.1, 0.2, -65.0, 2.0}, 0, 1}});
+        sim.connectRandom(0.1, 0.5, 1.0, 1, "exc");
+        sim.connectRandom(0.1, -1.0, 1.0, 2, "inh");
+    }
+}
+
+} // namespace
+
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent),
       controlPanel_(new ControlPanelWidget(this)),
@@ -25,7 +52,9 @@ MainWindow::MainWindow(QWidget* parent)
       rasterView_(new RasterPlotWidget(this)),
       simulation_(nullptr),
       simTimer_(new QTimer(this)),
-      currentInput_(0.0)
+      currentInput_(0.0),
+      threadCount_(1),
+      network_(0)
 {
     setupUi();
     connectSignals();
@@ -61,9 +90,11 @@ void MainWindow::connectSignals()
     connect(controlPanel_, &ControlPanelWidget::startSimulation, this, &MainWindow::onStartSimulation);
     connect(controlPanel_, &ControlPanelWidget::stopSimulation, this, &MainWindow::onStopSimulation);
     connect(controlPanel_, &ControlPanelWidget::gridSizeChanged, this, &MainWindow::onGridSizeChanged);
+    connect(controlPanel_, &ControlPanelWidget::networkChanged, this, &MainWindow::onNetworkChanged);
     connect(controlPanel_, &ControlPanelWidget::inputCurrentChanged, this, &MainWindow::onInputCurrentChanged);
     connect(controlPanel_, &ControlPanelWidget::displayModeChanged, this, &MainWindow::onDisplayModeChanged);
     connect(controlPanel_, &ControlPanelWidget::neuronSelected, this, &MainWindow::onNeuronSelected);
+    connect(controlPanel_, &ControlPanelWidget::threadCountChanged, this, &MainWindow::onThreadCountChanged);
     connect(simTimer_, &QTimer::timeout, this, &MainWindow::onSimulationStep);
 }
 
@@ -80,8 +111,11 @@ void MainWindow::onStopSimulation()
 void MainWindow::onGridSizeChanged(int nx, int ny)
 {
     delete simulation_;
-    simulation_ = new Simulation(nx, ny);
+    simulation_ = new Simulation(nx, ny, 0.1, threadCount_);
+    applyNetwork(*simulation_, network_);
     simulation_->setInputCurrent(currentInput_);
+    simulation_->setSpikeRetention(SpikeStore::Retention::KeepWindow, 1000.0);
+    simulation_->trackSpikeRate(100.0);  // heatmap SpikeRate window
 
     heatmapView_->setSimulation(simulation_);
     traceView_->setSimulation(simulation_);
@@ -92,6 +126,14 @@ void MainWindow::onGridSizeChanged(int nx, int ny)
     rasterView_->updateView();
 }
 
+void MainWindow::onNetworkChanged(int networkIndex)
+{
+    network_ = networkIndex;
+    if (simulation_) {
+        onGridSizeChanged(simulation_->nx(), simulation_->ny());
+    }
+}
+
 void MainWindow::onInputCurrentChanged(double current)
 {
     currentInput_ = current;
@@ -113,6 +155,14 @@ void MainWindow::onNeuronSelected(int neuronIndex)
     }
 }
 
+void MainWindow::onThreadCountChanged(int threads)
+{
+    threadCount_ = threads;
+    if (simulation_) {
+        simulation_->setThreadCount(threads);
+    }
+}
+
 void MainWindow::onSimulationStep()
 {
     if (simulation_) {
@@ -54,6 +54,13 @@ private slots:
      */
     void onGridSizeChanged(int nx, int ny);
 
+    /**
+     * @brief Reinitializes the simulation with another network preset.
+     * @param networkIndex 0: LIF, 1: Izhikevich regular spiking (RS),
+     *        2: excitatory RS and inhibitory fast-spiking (FS) Izhikevich populations.
+     */
+    void onNetworkChanged(int networkIndex);
+
     /**
      * @brief Updates the input current for all neurons.
      * @param current Input current in nA.
@@ -72,6 +79,12 @@ private slots:
      */
     void onNeuronSelected(int neuronIndex);
 
+    /**
+     * @brief Resizes the simulation's worker pool.
+     * @param threads Number of threads used per simulation step.
+     */
+    void onThreadCountChanged(int threads);
+
     /** Executes one simulation step and updates all visualizations. */
     void onSimulationStep();
 
@@ -90,6 +103,8 @@ private:
     Simulation*         simulation_;    ///< Underlying spiking neural network model
     QTimer*             simTimer_;      ///< Drives simulation steps
     double              currentInput_;  ///< Global external input current
+    int                 threadCount_;   ///< Worker threads per simulation step
+    int                 network_;       ///< Selected network preset
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,74 @@
+/**
+ * @file ModelRegistry.cpp
+ * @brief Implements the neuron model registry and registers the built-in models.
+ * @author Dario Romandini
+ */
+
+#include "ModelRegistry.h"
+#include "NeuronModels.h"
+#include <stdexcept>
+
+ModelRegistry::ModelRegistry()
+{
+    add<LifModel>();
+    add<IzhikevichModel>();
+}
+
+ModelRegistry& ModelRegistry::instance()
+{
+    static ModelRegistry registry;
+    return registry;
+}
+
+const ModelDescriptor& ModelRegistry::add(ModelDescriptor model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& existing : models_) {
+        if (existing->name != model.name) continue;
+        if (existing->stateNames == model.stateNames && existing->paramNames == model.paramNames &&
+            existing->derivedNames == model.derivedNames) {
+            return *existing;
+        }
+        throw std::invalid_argument("ModelRegistry: model name already in use: " + model.name);
+    }
+    models_.push_back(std::make_unique<ModelDescriptor>(std::move(model)));
+    return *models_.back();
+}
+
+const ModelDescriptor* ModelRegistry::find(std::string_view name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& model : models_) {
+        if (model->name == name) return model.get();
+    }
+    return nullptr;
+}
+
+const ModelDescriptor& ModelRegistry::get(std::string_view name) const
+{
+    const ModelDescriptor* model = find(name);
+    if (!model) {
+        throw std::invalid_argument("ModelRegistry: unknown neuron model " + std::string(name));
+    }
+    return *model;
+}
+
+std::vector<std::string> ModelRegistry::names() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    for (const auto& model : models_) names.push_back(model->name);
+    return names;
+}
+
+const ModelDescriptor& ModelRegistry::lif()
+{
+    static const ModelDescriptor& model = instance().get(LifModel::name);
+    return model;
+}
+
+const ModelDescriptor& ModelRegistry::izhikevich()
+{
+    static const ModelDescriptor& model = instance().get(IzhikevichModel::name);
+    return model;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file ModelRegistry.h
+ * @brief Process-wide table of neuron models by name.
+ * @author Dario Romandini
+ */
+
+#ifndef MODEL_REGISTRY_H
+#define MODEL_REGISTRY_H
+
+#include "NeuronModel.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ModelRegistry
+ * @brief Maps model names to the descriptors NeuronPopulation is built from.
+ *
+ * The built-in "lif" (LifModel) and "izhikevich" (IzhikevichModel) models
+ * are always present. Further models are added with add<M>() for any type
+ * satisfying NeuronModel; they get the portable kernel instantiated for M,
+ * while the built-ins also have vectorized kernels in every NeuronKernels
+ * set. Descriptors are never removed, so references stay valid for the
+ * lifetime of the process.
+ */
+class ModelRegistry
+{
+public:
+    /** @return The process-wide registry. */
+    static ModelRegistry& instance();
+
+    /**
+     * @brief Register model M under M::name.
+     * @return The descriptor of M (the existing one if already registered).
+     * @throws std::invalid_argument if another model uses the same name.
+     */
+    template <NeuronModel M>
+    const ModelDescriptor& add()
+    {
+        return add(describeModel<M>());
+    }
+
+    /** @copydoc add() */
+    const ModelDescriptor& add(ModelDescriptor model);
+
+    /** @return Descriptor of the model called @p name, or nullptr. */
+    const ModelDescriptor* find(std::string_view name) const;
+
+    /**
+     * @return Descriptor of the model called @p name.
+     * @throws std::invalid_argument if no such model is registered.
+     */
+    const ModelDescriptor& get(std::string_view name) const;
+
+    /** @return Names of all registered models, in registration order. */
+    std::vector<std::string> names() const;
+
+    /** @return Descriptor of LifModel. */
+    static const ModelDescriptor& lif();
+
+    /** @return Descriptor of IzhikevichModel. */
+    static const ModelDescriptor& izhikevich();
+
+private:
+    ModelRegistry();
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ModelDescriptor>> models_;  ///< Stable descriptor storage
+};
+
+#endif // MODEL_REGISTRY_H
@@ -0,0 +1,61 @@
+/**
+ * @file NeuronKernels.cpp
+ * @brief Scalar kernel set and runtime selection of the vectorized kernel sets.
+ * @author Dario Romandini
+ */
+
+#include "NeuronKernels.h"
+#include "NeuronModels.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifdef NEUROSIM_HAVE_X86_KERNELS
+extern const NeuronKernels avx2NeuronKernels;
+extern const NeuronKernels avx512NeuronKernels;
+#endif
+
+static const NeuronKernels scalarNeuronKernels = {
+    NeuronKernels::Isa::Scalar, "scalar", 1,
+    NEUROSIM_LIF_KERNELS(modelUpdateScalar, LifModel, double),
+    NEUROSIM_IZHIKEVICH_KERNELS(modelUpdateScalar, IzhikevichModel, double),
+    NEUROSIM_LIF_KERNELS(modelUpdateScalar, LifModel, float),
+    NEUROSIM_IZHIKEVICH_KERNELS(modelUpdateScalar, IzhikevichModel, float)
+};
+
+void appendFired(std::vector<int>& fired, const int* indices, int n)
+{
+    fired.insert(fired.end(), indices, indices + n);
+}
+
+static const NeuronKernels& selectKernels()
+{
+    auto sets = NeuronKernels::available();
+
+    if (const char* requested = std::getenv("NEUROSIM_KERNELS")) {
+        for (const NeuronKernels* k : sets) {
+            if (std::strcmp(k->name, requested) == 0) return *k;
+        }
+    }
+    return *sets.back();
+}
+
+const NeuronKernels& NeuronKernels::active()
+{
+    static const NeuronKernels& kernels = selectKernels();
+    return kernels;
+}
+
+const NeuronKernels& NeuronKernels::scalar()
+{
+    return scalarNeuronKernels;
+}
+
+std::vector<const NeuronKernels*> NeuronKernels::available()
+{
+    std::vector<const NeuronKernels*> sets{&scalarNeuronKernels};
+#ifdef NEUROSIM_HAVE_X86_KERNELS
+    if (__builtin_cpu_supports("avx2")) sets.push_back(&avx2NeuronKernels);
+    if (__builtin_cpu_supports("avx512f")) sets.push_back(&avx512NeuronKernels);
+#endif
+    return sets;
+}
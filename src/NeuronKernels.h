@@ -0,0 +1,170 @@
+/**
+ * @file NeuronKernels.h
+ * @brief Vectorized neuron update kernels selected at runtime by CPU features.
+ * @author Dario Romandini
+ */
+
+#ifndef NEURON_KERNELS_H
+#define NEURON_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @struct ModelArraysT
+ * @brief Pointers into the structure-of-arrays storage of a population.
+ *
+ * Holds one array per state variable and per parameter of the neuron model,
+ * in the order of the model's field lists (see NeuronModel.h).
+ *
+ * @tparam T Scalar type of the state (double or float).
+ */
+template <typename T>
+struct ModelArraysT
+{
+    T* const* state;         ///< State variable arrays; state[0] is the membrane potential
+    const T* const* params;  ///< Parameter arrays
+    T* i_syn;
+    T* i_ext;
+    T* i_total;              ///< Receives the total input current of the update
+    T* last_spike_t;
+    std::uint8_t* spiked;
+};
+
+/**
+ * @brief Integration scheme of the LIF kernels.
+ *
+ * Between spikes the LIF equation is linear, so with the input held constant
+ * over a step it has the closed-form solution
+ * v(t + dt) = v_inf + (v(t) - v_inf) · exp(-dt / tau), v_inf = v_rest + I.
+ * The exact scheme applies it with a propagator precomputed per neuron, and
+ * stays accurate and stable at any dt.
+ */
+enum class LifIntegrator
+{
+    Euler,  ///< Forward Euler
+    Exact   ///< Exact exponential propagator for piecewise-constant input
+};
+
+/// Number of LifIntegrator values.
+inline constexpr int lifIntegratorCount = 2;
+
+/**
+ * @brief Integration scheme of the Izhikevich kernels.
+ *
+ * Every scheme advances the state by exactly dt per step, split into a fixed
+ * number of substeps; the spike threshold is checked after each substep.
+ */
+enum class IzhikevichIntegrator
+{
+    Euler,             ///< Forward Euler
+    ExponentialEuler,  ///< Exponential Euler on the linearized v equation, exact u decay
+    RK2,               ///< Heun's second-order Runge-Kutta
+    RK4                ///< Classical fourth-order Runge-Kutta
+};
+
+/// Number of IzhikevichIntegrator values.
+inline constexpr int izhikevichIntegratorCount = 4;
+
+/**
+ * @brief Signature of a kernel advancing neurons [begin, end) by one step.
+ *
+ * Every kernel consumes the synaptic/external input, records the total input
+ * (external + synaptic + bias) in i_total, updates spike flags and
+ * appends the indices of spiking neurons to @p fired (if non-null) in ascending
+ * order. Each step is split into @p substeps integration substeps of
+ * dt / substeps; the spike threshold is checked after every substep.
+ */
+template <typename T>
+using ModelKernelT = void (*)(const ModelArraysT<T>& s, T dt, T i_bias, int substeps,
+                              std::size_t begin, std::size_t end, std::vector<int>* fired);
+
+using ModelKernel = ModelKernelT<double>;
+
+/**
+ * @brief Append @p n indices of spiking neurons to @p fired.
+ *
+ * Defined out of line so that the vectorized kernels, compiled for wider
+ * instruction sets, never instantiate std::vector code of their own.
+ */
+void appendFired(std::vector<int>& fired, const int* indices, int n);
+
+struct LifModel;
+struct IzhikevichModel;
+
+/**
+ * @struct NeuronKernels
+ * @brief A set of update kernels compiled for one instruction set.
+ *
+ * The scalar set is always available. On x86-64 GCC/Clang builds, AVX2 (4 lanes)
+ * and AVX-512 (8 lanes) sets are compiled into separate translation units and
+ * the fastest one supported by the running CPU is picked on first use. The
+ * NEUROSIM_KERNELS environment variable ("scalar", "avx2", "avx512") overrides
+ * the choice. All sets produce bit-identical results, in double and in single
+ * precision (a float vector holds twice as many neurons).
+ */
+struct NeuronKernels
+{
+    enum class Isa { Scalar, Avx2, Avx512 };
+
+    Isa isa;                      ///< Instruction set of the kernels
+    const char* name;             ///< Human-readable name
+    int lanes;                    ///< Neurons processed per instruction (double)
+    ModelKernel lif[lifIntegratorCount];                 ///< LifModel kernel per integrator
+    ModelKernel izhikevich[izhikevichIntegratorCount];   ///< IzhikevichModel kernel per integrator
+    ModelKernelT<float> lifFloat[lifIntegratorCount];    ///< Single-precision LifModel kernels
+    ModelKernelT<float> izhikevichFloat[izhikevichIntegratorCount];  ///< Single-precision IzhikevichModel kernels
+
+    /**
+     * @brief Kernel of this set for neuron model M.
+     * @tparam M Neuron model.
+     * @tparam T Scalar type of the state.
+     * @param integrator Index of the model's integrator.
+     * @return The kernel, or nullptr if the set has no kernels for M (the
+     *         model's portable kernel is used instead).
+     */
+    template <typename M, typename T>
+    ModelKernelT<T> kernel(int integrator) const
+    {
+        constexpr bool single = std::is_same_v<T, float>;
+        if constexpr (std::is_same_v<M, LifModel>) {
+            if constexpr (single) return lifFloat[integrator];
+            else return lif[integrator];
+        } else if constexpr (std::is_same_v<M, IzhikevichModel>) {
+            if constexpr (single) return izhikevichFloat[integrator];
+            else return izhikevich[integrator];
+        } else {
+            return nullptr;
+        }
+    }
+
+    /** @return Kernel set used by NeuronPopulation (chosen once per process). */
+    static const NeuronKernels& active();
+
+    /** @return The portable scalar kernel set. */
+    static const NeuronKernels& scalar();
+
+    /** @return All kernel sets compiled in and supported by this CPU. */
+    static std::vector<const NeuronKernels*> available();
+};
+
+/**
+ * @brief Brace-initializer of a NeuronKernels LIF table: one instantiation of
+ *        the kernel template per LifIntegrator.
+ * @param KERNEL Kernel template taking <leading arguments..., LifIntegrator>.
+ * @param ... Leading template arguments (model, scalar type, vector width).
+ */
+#define NEUROSIM_LIF_KERNELS(KERNEL, ...)                 \
+    {&KERNEL<__VA_ARGS__, LifIntegrator::Euler>,          \
+     &KERNEL<__VA_ARGS__, LifIntegrator::Exact>}
+
+/// Brace-initializer of a NeuronKernels Izhikevich table, like NEUROSIM_LIF_KERNELS.
+#define NEUROSIM_IZHIKEVICH_KERNELS(KERNEL, ...)                     \
+    {&KERNEL<__VA_ARGS__, IzhikevichIntegrator::Euler>,              \
+     &KERNEL<__VA_ARGS__, IzhikevichIntegrator::ExponentialEuler>,   \
+     &KERNEL<__VA_ARGS__, IzhikevichIntegrator::RK2>,                \
+     &KERNEL<__VA_ARGS__, IzhikevichIntegrator::RK4>}
+
+#endif // NEURON_KERNELS_H
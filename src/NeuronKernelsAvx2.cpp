@@ -0,0 +1,15 @@
+/**
+ * @file NeuronKernelsAvx2.cpp
+ * @brief AVX2 instantiation of the neuron kernels (compiled with -mavx2).
+ * @author Dario Romandini
+ */
+
+#include "NeuronKernelsSimd.h"
+
+extern const NeuronKernels avx2NeuronKernels = {
+    NeuronKernels::Isa::Avx2, "avx2", 4,
+    NEUROSIM_LIF_KERNELS(modelUpdateSimd, LifModel, double, 32),
+    NEUROSIM_IZHIKEVICH_KERNELS(modelUpdateSimd, IzhikevichModel, double, 32),
+    NEUROSIM_LIF_KERNELS(modelUpdateSimd, LifModel, float, 32),
+    NEUROSIM_IZHIKEVICH_KERNELS(modelUpdateSimd, IzhikevichModel, float, 32)
+};
@@ -0,0 +1,15 @@
+/**
+ * @file NeuronKernelsAvx512.cpp
+ * @brief AVX-512 instantiation of the neuron kernels (compiled with -mavx512f).
+ * @author Dario Romandini
+ */
+
+#include "NeuronKernelsSimd.h"
+
+extern const NeuronKernels avx512NeuronKernels = {
+    NeuronKernels::Isa::Avx512, "avx512", 8,
+    NEUROSIM_LIF_KERNELS(modelUpdateSimd, LifModel, double, 64),
+    NEUROSIM_IZHIKEVICH_KERNELS(modelUpdateSimd, IzhikevichModel, double, 64),
+    NEUROSIM_LIF_KERNELS(modelUpdateSimd, LifModel, float, 64),
+    NEUROSIM_IZHIKEVICH_KERNELS(modelUpdateSimd, IzhikevichModel, float, 64)
+};
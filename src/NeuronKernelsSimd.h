@@ -0,0 +1,160 @@
+/**
+ * @file NeuronKernelsSimd.h
+ * @brief Width-generic neuron model kernels using GCC/Clang vector extensions.
+ * @author Dario Romandini
+ *
+ * Included only by the per-ISA kernel translation units, each compiled with its
+ * own target flags. The anonymous namespace keeps the kernels themselves
+ * local, but any inline function or template those units instantiate outside
+ * it (std::vector members, std::exp, ...) is emitted as a weak symbol that the
+ * linker may pick over the baseline copy of another unit, and would then run
+ * wider instructions in scalar code. The kernels therefore instantiate nothing
+ * shared: pointer tables are plain arrays, spikes are appended through the
+ * out-of-line appendFired(), and laneExp() calls the C library on vector
+ * lanes. The only shared templates left are the model's own functions on
+ * vector types, which no other unit instantiates. The kernels run the model's
+ * own update() on vectors, so the arithmetic mirrors modelUpdateScalar()
+ * operation for operation and, with floating-point contraction disabled, the
+ * results are bit-identical. The last, partial vector of a range is padded
+ * rather than handed to the scalar kernel, so no scalar code is instantiated
+ * under the wider instruction set.
+ */
+
+#ifndef NEURON_KERNELS_SIMD_H
+#define NEURON_KERNELS_SIMD_H
+
+#include "NeuronKernels.h"
+#include "NeuronModels.h"
+#include <cstring>
+
+namespace {
+
+// Vector types must be declared non-dependently (GCC drops vector_size on
+// typedefs that depend on a template parameter).
+template <typename T, int Bytes> struct VecTypes;
+
+template <> struct VecTypes<double, 32>
+{
+    typedef double Vec __attribute__((vector_size(32)));
+    typedef std::int64_t Mask __attribute__((vector_size(32)));
+};
+
+template <> struct VecTypes<double, 64>
+{
+    typedef double Vec __attribute__((vector_size(64)));
+    typedef std::int64_t Mask __attribute__((vector_size(64)));
+};
+
+template <> struct VecTypes<float, 32>
+{
+    typedef float Vec __attribute__((vector_size(32)));
+    typedef std::int32_t Mask __attribute__((vector_size(32)));
+};
+
+template <> struct VecTypes<float, 64>
+{
+    typedef float Vec __attribute__((vector_size(64)));
+    typedef std::int32_t Mask __attribute__((vector_size(64)));
+};
+
+/** @brief Vector operations on a register of Bytes bytes holding W values of type T. */
+template <typename T, int Bytes>
+struct Simd
+{
+    using Vec = typename VecTypes<T, Bytes>::Vec;
+    using Mask = typename VecTypes<T, Bytes>::Mask;
+    static constexpr int W = Bytes / static_cast<int>(sizeof(T));
+
+    /** @brief Load the first n lanes (the others are zero). */
+    static Vec load(const T* p, int n = W)
+    {
+        Vec r = {};
+        if (n == W) std::memcpy(&r, p, sizeof(r));
+        else std::memcpy(&r, p, n * sizeof(T));
+        return r;
+    }
+
+    /** @brief Store the first n lanes. */
+    static void store(T* p, Vec v, int n = W)
+    {
+        if (n == W) std::memcpy(p, &v, sizeof(v));
+        else std::memcpy(p, &v, n * sizeof(T));
+    }
+
+    static bool any(Mask m)
+    {
+        bool r = false;
+        for (int l = 0; l < W; ++l) r |= (m[l] != 0);
+        return r;
+    }
+
+    /** @brief Write the spike flags and markers of n lanes, and collect spiking indices. */
+    static void recordSpikes(Mask m, std::size_t i, int n, std::uint8_t* spiked,
+                             T* last_spike_t, std::vector<int>* fired)
+    {
+        if (!any(m)) {
+            std::memset(spiked + i, 0, n);
+            return;
+        }
+        int indices[W];
+        int count = 0;
+        for (int l = 0; l < n; ++l) {
+            bool spike = m[l] != 0;
+            spiked[i + l] = spike;
+            if (spike) {
+                last_spike_t[i + l] = 0;
+                indices[count++] = static_cast<int>(i + l);
+            }
+        }
+        if (fired) appendFired(*fired, indices, count);
+    }
+};
+
+/** @brief Vectorized kernel of model M with integrator I (see ModelKernelT). */
+template <typename M, typename T, int Bytes, auto I>
+void modelUpdateSimd(const ModelArraysT<T>& s, T dt, T i_bias, int substeps,
+                     std::size_t begin, std::size_t end, std::vector<int>* fired)
+{
+    using S = Simd<T, Bytes>;
+    using Vec = typename S::Vec;
+    using Mask = typename S::Mask;
+    constexpr int W = S::W;
+
+    // Local copies of the array pointers, so they stay in registers.
+    constexpr std::size_t stateCount = M::stateNames.size();
+    constexpr std::size_t paramCount = modelParamFieldCount<M>;
+    T* state[stateCount];
+    const T* params[paramCount];
+    for (std::size_t k = 0; k < stateCount; ++k) state[k] = s.state[k];
+    for (std::size_t k = 0; k < paramCount; ++k) params[k] = s.params[k];
+
+    const Vec zero = {};
+    const T h = dt / T(substeps);
+    auto block = [&](std::size_t i, int n) __attribute__((always_inline)) {
+        typename M::template State<Vec> st;
+        typename M::template Params<Vec> p;
+        forEachField(M::stateFields(st), [&](Vec& f, std::size_t k) { f = S::load(state[k] + i, n); });
+        forEachField(M::paramFields(p), [&](Vec& f, std::size_t k) { f = S::load(params[k] + i, n); });
+        Vec input = S::load(s.i_ext + i, n) + (S::load(s.i_syn + i, n) + i_bias);
+        S::store(s.i_total + i, input, n);
+
+        // Padding lanes may compute inf/NaN; they are never stored.
+        Mask spike = {};
+        for (int k = 0; k < substeps; ++k) {
+            spike |= M::template update<I>(st, p, h, input);
+        }
+        S::recordSpikes(spike, i, n, s.spiked, s.last_spike_t, fired);
+
+        forEachField(M::stateFields(st), [&](Vec& f, std::size_t k) { S::store(state[k] + i, f, n); });
+        S::store(s.i_syn + i, zero, n);
+        S::store(s.i_ext + i, zero, n);
+    };
+
+    std::size_t i = begin;
+    for (; i + W <= end; i += W) block(i, W);
+    if (i < end) block(i, static_cast<int>(end - i));
+}
+
+} // namespace
+
+#endif // NEURON_KERNELS_SIMD_H
@@ -0,0 +1,312 @@
+/**
+ * @file NeuronModel.h
+ * @brief Compile-time interface of neuron models and their generic update kernel.
+ * @author Dario Romandini
+ *
+ * A neuron model is a stateless struct describing one neuron's dynamics:
+ *
+ * @code
+ * struct MyModel
+ * {
+ *     static constexpr const char* name = "my_model";
+ *     enum class Integrator { Euler };
+ *     static constexpr int integratorCount = 1;
+ *     static constexpr std::array<const char*, 2> stateNames{"v", "w"};
+ *     static constexpr std::array<const char*, 1> paramNames{"tau"};
+ *
+ *     template <typename V> struct State { V v, w; };
+ *     template <typename V> struct Params { V tau; };
+ *
+ *     template <typename S> static auto stateFields(S& s) { return std::tie(s.v, s.w); }
+ *     template <typename P> static auto paramFields(P& p) { return std::tie(p.tau); }
+ *
+ *     template <typename T> static Params<T> defaults();
+ *     template <typename T> static State<T> initialState(const Params<T>& p);
+ *
+ *     // One substep of length dt; applies the reset and returns the spike mask.
+ *     template <Integrator I, typename V, typename T>
+ *     static auto update(State<V>& s, const Params<V>& p, T dt, const V& input);
+ * };
+ * @endcode
+ *
+ * State and Params are templated on V so that the same update() runs on a
+ * scalar (V = T, returning bool) and on a SIMD register holding several
+ * neurons (V = vector of T, returning a lane mask); it must therefore be
+ * branch-free, selecting with `mask ? a : b`. The first state variable is the
+ * membrane potential. A model may also define
+ * `template <typename T> static void prepare(Params<T>& p, double dt)` to
+ * derive fields from the step length (e.g. a propagator). Derived fields
+ * follow the parameters in Params and paramFields() and are named in a
+ * separate `derivedNames` array; they are stored per neuron like the
+ * parameters but cannot be set and are not published. Finally, a
+ * `static constexpr std::array<double, integratorCount> cost` gives the
+ * relative cost of one substep per neuron of each integrator (1 = a forward
+ * Euler LIF step; defaults to 1), which Simulation uses to balance threads.
+ *
+ * Models are instantiated into fully inlined structure-of-arrays kernels
+ * (modelUpdateScalar() here, modelUpdateSimd() for the vectorized kernel
+ * sets) and registered by name in the ModelRegistry, which NeuronPopulation
+ * uses. Nothing is dispatched per neuron.
+ */
+
+#ifndef NEURON_MODEL_H
+#define NEURON_MODEL_H
+
+#include "NeuronKernels.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// Largest number of state variables or parameter fields of a model.
+inline constexpr std::size_t maxModelFields = 16;
+
+/**
+ * @concept NeuronModel
+ * @brief Requirements on a neuron model struct (see the file description).
+ */
+template <typename M>
+concept NeuronModel = requires(typename M::template State<double>& s,
+                               typename M::template Params<double>& p, double dt, double input) {
+    { M::name } -> std::convertible_to<const char*>;
+    { M::integratorCount } -> std::convertible_to<int>;
+    { M::stateNames.size() } -> std::convertible_to<std::size_t>;
+    { M::paramNames.size() } -> std::convertible_to<std::size_t>;
+    M::stateFields(s);
+    M::paramFields(p);
+    { M::template defaults<double>() } -> std::same_as<typename M::template Params<double>>;
+    { M::initialState(std::as_const(p)) } -> std::same_as<typename M::template State<double>>;
+    { M::template update<static_cast<typename M::Integrator>(0)>(s, std::as_const(p), dt, input) }
+        -> std::convertible_to<bool>;
+};
+
+/** @brief Whether model M derives parameters from the step length. */
+template <typename M>
+concept PreparedNeuronModel = NeuronModel<M> && requires(typename M::template Params<double>& p) {
+    M::prepare(p, 0.1);
+};
+
+/** @brief Number of per-neuron parameter fields of model M: parameters, then derived fields. */
+template <typename M>
+inline constexpr std::size_t modelParamFieldCount = [] {
+    if constexpr (requires { M::derivedNames.size(); }) {
+        return M::paramNames.size() + M::derivedNames.size();
+    } else {
+        return M::paramNames.size();
+    }
+}();
+
+/**
+ * @brief Element-wise std::exp of a scalar or of every lane of a vector.
+ *
+ * Vector lanes go through the C library's exp/expf, which std::exp calls, so
+ * vectorized kernels match the scalar ones bit for bit.
+ */
+template <typename V>
+inline V laneExp(V x)
+{
+    if constexpr (std::is_arithmetic_v<V>) {
+        return std::exp(x);
+    } else {
+        using T = std::remove_cvref_t<decltype(x[0])>;
+        for (std::size_t l = 0; l < sizeof(V) / sizeof(T); ++l) {
+            if constexpr (std::is_same_v<T, float>) x[l] = ::expf(x[l]);
+            else x[l] = ::exp(x[l]);
+        }
+        return x;
+    }
+}
+
+/** @brief Call fn(field, index) for every element of a tuple of references. */
+template <typename Tuple, typename Fn>
+inline void forEachField(Tuple&& fields, Fn&& fn)
+{
+    constexpr std::size_t n = std::tuple_size_v<std::decay_t<Tuple>>;
+    [&]<std::size_t... k>(std::index_sequence<k...>) {
+        (fn(std::get<k>(fields), k), ...);
+    }(std::make_index_sequence<n>{});
+}
+
+/**
+ * @brief Portable kernel of model M with integrator I (see ModelKernelT).
+ *
+ * Loads each neuron's state and parameters from the arrays, runs the
+ * model's update once per substep and stores the state back.
+ */
+template <typename M, typename T, auto I>
+void modelUpdateScalar(const ModelArraysT<T>& s, T dt, T i_bias, int substeps,
+                       std::size_t begin, std::size_t end, std::vector<int>* fired)
+{
+    // Local copies of the array pointers, so they stay in registers.
+    std::array<T*, M::stateNames.size()> state;
+    std::array<const T*, modelParamFieldCount<M>> params;
+    std::copy_n(s.state, state.size(), state.begin());
+    std::copy_n(s.params, params.size(), params.begin());
+
+    const T h = dt / T(substeps);
+    for (std::size_t i = begin; i < end; ++i) {
+        typename M::template State<T> st;
+        typename M::template Params<T> p;
+        forEachField(M::stateFields(st), [&](T& f, std::size_t k) { f = state[k][i]; });
+        forEachField(M::paramFields(p), [&](T& f, std::size_t k) { f = params[k][i]; });
+        T input = s.i_ext[i] + (s.i_syn[i] + i_bias);
+        s.i_total[i] = input;
+
+        bool spike = false;
+        for (int k = 0; k < substeps; ++k) {
+            spike |= M::template update<I>(st, p, h, input);
+        }
+
+        if (spike) {
+            s.last_spike_t[i] = 0;
+            if (fired) fired->push_back(static_cast<int>(i));
+        }
+
+        forEachField(M::stateFields(st), [&](T& f, std::size_t k) { state[k][i] = f; });
+        s.spiked[i] = spike;
+        s.i_syn[i] = 0;
+        s.i_ext[i] = 0;
+    }
+}
+
+/**
+ * @struct ModelOpsT
+ * @brief Type-erased operations of a model in one scalar type.
+ */
+template <typename T>
+struct ModelOpsT
+{
+    std::vector<ModelKernelT<T>> kernels;  ///< Portable kernel per integrator
+
+    /// Kernel of a vectorized kernel set, or nullptr if the set has none for the model.
+    ModelKernelT<T> (*specialized)(const NeuronKernels& set, int integrator);
+
+    /// Derives parameters of neurons [0, n) for step dt; nullptr if the model has none.
+    void (*prepare)(T* const* params, std::size_t n, double dt);
+};
+
+/**
+ * @struct ModelDescriptor
+ * @brief Runtime description of a registered neuron model.
+ */
+struct ModelDescriptor
+{
+    std::string name;                     ///< Registry name
+    std::vector<std::string> stateNames;  ///< State variables; the first is the membrane potential
+    std::vector<std::string> paramNames;  ///< Per-neuron parameters
+    std::vector<std::string> derivedNames;  ///< Fields derived by prepare(), stored after the parameters
+    std::vector<double> defaults;         ///< Default parameter values
+    int integratorCount;                  ///< Number of integrators
+    std::vector<double> cost;             ///< Relative cost per neuron and substep of each integrator
+
+    /// Writes the initial state for the given parameters, without derived fields (both in double).
+    void (*initialState)(const double* params, double* state);
+
+    ModelOpsT<double> doubleOps;  ///< Operations in double precision
+    ModelOpsT<float> floatOps;    ///< Operations in single precision
+
+    /** @return Operations in scalar type T. */
+    template <typename T>
+    const ModelOpsT<T>& ops() const
+    {
+        if constexpr (std::is_same_v<T, float>) return floatOps;
+        else return doubleOps;
+    }
+
+    /** @return Index of a state variable, or -1. */
+    int stateIndex(std::string_view field) const { return indexOf(stateNames, field); }
+
+    /** @return Index of a parameter, or -1. */
+    int paramIndex(std::string_view field) const { return indexOf(paramNames, field); }
+
+private:
+    static int indexOf(const std::vector<std::string>& names, std::string_view field)
+    {
+        for (std::size_t k = 0; k < names.size(); ++k) {
+            if (names[k] == field) return static_cast<int>(k);
+        }
+        return -1;
+    }
+};
+
+/** @brief Operations of model M in scalar type T. */
+template <NeuronModel M, typename T>
+ModelOpsT<T> modelOps()
+{
+    ModelOpsT<T> ops;
+    [&]<std::size_t... k>(std::index_sequence<k...>) {
+        ops.kernels = {&modelUpdateScalar<M, T, static_cast<typename M::Integrator>(k)>...};
+    }(std::make_index_sequence<M::integratorCount>{});
+
+    ops.specialized = [](const NeuronKernels& set, int integrator) {
+        return set.template kernel<M, T>(integrator);
+    };
+
+    ops.prepare = nullptr;
+    if constexpr (PreparedNeuronModel<M>) {
+        ops.prepare = [](T* const* params, std::size_t n, double dt) {
+            for (std::size_t i = 0; i < n; ++i) {
+                typename M::template Params<T> p;
+                forEachField(M::paramFields(p), [&](T& f, std::size_t k) { f = params[k][i]; });
+                M::prepare(p, dt);
+                forEachField(M::paramFields(p), [&](T& f, std::size_t k) { params[k][i] = f; });
+            }
+        };
+    }
+    return ops;
+}
+
+/** @brief Build the runtime description of model M. */
+template <NeuronModel M>
+ModelDescriptor describeModel()
+{
+    using State = typename M::template State<double>;
+    using Params = typename M::template Params<double>;
+    static_assert(std::tuple_size_v<decltype(M::stateFields(std::declval<State&>()))> ==
+                  M::stateNames.size(), "one name per state variable");
+    constexpr std::size_t paramCount = M::paramNames.size();
+    static_assert(std::tuple_size_v<decltype(M::paramFields(std::declval<Params&>()))> ==
+                  modelParamFieldCount<M>, "one name per parameter and derived field");
+    static_assert(M::stateNames.size() >= 1 && M::stateNames.size() <= maxModelFields &&
+                  modelParamFieldCount<M> <= maxModelFields, "unsupported number of fields");
+
+    ModelDescriptor d;
+    d.name = M::name;
+    d.stateNames.assign(M::stateNames.begin(), M::stateNames.end());
+    d.paramNames.assign(M::paramNames.begin(), M::paramNames.end());
+    if constexpr (requires { M::derivedNames; }) {
+        d.derivedNames.assign(M::derivedNames.begin(), M::derivedNames.end());
+    }
+    d.integratorCount = M::integratorCount;
+    if constexpr (requires { M::cost; }) {
+        static_assert(M::cost.size() == M::integratorCount, "one cost per integrator");
+        d.cost.assign(M::cost.begin(), M::cost.end());
+    } else {
+        d.cost.assign(M::integratorCount, 1.0);
+    }
+
+    Params defaults = M::template defaults<double>();
+    forEachField(M::paramFields(defaults), [&](double f, std::size_t k) {
+        if (k < paramCount) d.defaults.push_back(f);
+    });
+
+    d.initialState = [](const double* params, double* state) {
+        Params p = M::template defaults<double>();
+        forEachField(M::paramFields(p), [&](double& f, std::size_t k) {
+            if (k < paramCount) f = params[k];
+        });
+        State s = M::initialState(p);
+        forEachField(M::stateFields(s), [&](double f, std::size_t k) { state[k] = f; });
+    };
+    d.doubleOps = modelOps<M, double>();
+    d.floatOps = modelOps<M, float>();
+    return d;
+}
+
+#endif // NEURON_MODEL_H
@@ -0,0 +1,140 @@
+/**
+ * @file NeuronModels.h
+ * @brief The built-in neuron models: leaky integrate-and-fire and Izhikevich.
+ * @author Dario Romandini
+ *
+ * Both satisfy the NeuronModel concept and are registered in the
+ * ModelRegistry as "lif" and "izhikevich". Besides the portable kernels,
+ * every NeuronKernels set carries vectorized instantiations of them.
+ */
+
+#ifndef NEURON_MODELS_H
+#define NEURON_MODELS_H
+
+#include "IzhikevichIntegrators.h"
+#include "NeuronKernels.h"
+#include "NeuronModel.h"
+#include <array>
+#include <cmath>
+#include <tuple>
+
+/**
+ * @struct LifModel
+ * @brief Leaky integrate-and-fire neuron, tau dv/dt = -(v - v_rest) + I.
+ */
+struct LifModel
+{
+    static constexpr const char* name = "lif";
+    using Integrator = LifIntegrator;
+    static constexpr int integratorCount = lifIntegratorCount;
+    static constexpr std::array<const char*, 1> stateNames{"v"};
+    static constexpr std::array<const char*, 4> paramNames{"v_rest", "v_thresh", "tau", "reset_v"};
+    static constexpr std::array<const char*, 1> derivedNames{"decay"};
+    static constexpr std::array<double, lifIntegratorCount> cost{1.0, 1.2};
+
+    template <typename V>
+    struct State
+    {
+        V v;  ///< Membrane potential (mV)
+    };
+
+    template <typename V>
+    struct Params
+    {
+        V v_rest;    ///< Resting potential (mV)
+        V v_thresh;  ///< Spiking threshold (mV)
+        V tau;       ///< Membrane time constant (ms)
+        V reset_v;   ///< Voltage after a spike (mV)
+        V decay;     ///< exp(-dt / tau), derived by prepare()
+    };
+
+    template <typename S>
+    static auto stateFields(S& s) { return std::tie(s.v); }
+
+    template <typename P>
+    static auto paramFields(P& p) { return std::tie(p.v_rest, p.v_thresh, p.tau, p.reset_v, p.decay); }
+
+    template <typename T>
+    static Params<T> defaults() { return {T(-65.0), T(-50.0), T(20.0), T(-65.0), T(0.0)}; }
+
+    template <typename T>
+    static State<T> initialState(const Params<T>& p) { return {p.v_rest}; }
+
+    /** @brief Precompute the exact propagator for substeps of dt. */
+    template <typename T>
+    static void prepare(Params<T>& p, double dt)
+    {
+        p.decay = static_cast<T>(std::exp(-dt / static_cast<double>(p.tau)));
+    }
+
+    template <Integrator I, typename V, typename T>
+    static auto update(State<V>& s, const Params<V>& p, T dt, const V& input)
+    {
+        if constexpr (I == LifIntegrator::Exact) {
+            V v_inf = p.v_rest + input;
+            s.v = v_inf + (s.v - v_inf) * p.decay;
+        } else {
+            s.v = s.v + dt * (-(s.v - p.v_rest) + input) / p.tau;
+        }
+
+        auto spike = s.v >= p.v_thresh;
+        s.v = spike ? p.reset_v : s.v;
+        return spike;
+    }
+};
+
+/**
+ * @struct IzhikevichModel
+ * @brief Izhikevich neuron: v' = 0.04v² + 5v + 140 - u + I, u' = a(bv - u),
+ *        with v ← c, u ← u + d when v reaches 30 mV.
+ */
+struct IzhikevichModel
+{
+    static constexpr const char* name = "izhikevich";
+    using Integrator = IzhikevichIntegrator;
+    static constexpr int integratorCount = izhikevichIntegratorCount;
+    static constexpr std::array<const char*, 2> stateNames{"v", "u"};
+    static constexpr std::array<const char*, 4> paramNames{"a", "b", "c", "d"};
+    static constexpr std::array<double, izhikevichIntegratorCount> cost{1.0, 6.0, 1.5, 3.0};
+
+    template <typename V>
+    struct State
+    {
+        V v;  ///< Membrane potential (mV)
+        V u;  ///< Recovery variable
+    };
+
+    template <typename V>
+    struct Params
+    {
+        V a;  ///< Recovery time constant
+        V b;  ///< Sensitivity of u to v
+        V c;  ///< Reset voltage (mV)
+        V d;  ///< Reset increment of u
+    };
+
+    template <typename S>
+    static auto stateFields(S& s) { return std::tie(s.v, s.u); }
+
+    template <typename P>
+    static auto paramFields(P& p) { return std::tie(p.a, p.b, p.c, p.d); }
+
+    template <typename T>
+    static Params<T> defaults() { return {T(0.02), T(0.2), T(-65.0), T(8.0)}; }
+
+    template <typename T>
+    static State<T> initialState(const Params<T>& p) { return {T(-65.0), p.b * T(-65.0)}; }
+
+    template <Integrator I, typename V, typename T>
+    static auto update(State<V>& s, const Params<V>& p, T dt, const V& input)
+    {
+        izhikevichSubstep<I>(s.v, s.u, p.a, p.b, input, dt);
+
+        auto reset = s.v >= T(30.0);
+        s.v = reset ? p.c : s.v;
+        s.u = reset ? s.u + p.d : s.u;
+        return reset;
+    }
+};
+
+#endif // NEURON_MODELS_H
@@ -0,0 +1,174 @@
+/**
+ * @file NeuronPopulation.cpp
+ * @brief Implements the structure-of-arrays neuron population update loops.
+ * @author Dario Romandini
+ */
+
+#include "NeuronPopulation.h"
+#include "ModelRegistry.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const ModelDescriptor& builtinModel(NeuronPopulation::Model model)
+{
+    return model == NeuronPopulation::Model::Izhikevich ? ModelRegistry::izhikevich()
+                                                        : ModelRegistry::lif();
+}
+
+} // namespace
+
+NeuronPopulation::NeuronPopulation(const ModelDescriptor& model, std::size_t size,
+                                   Precision precision)
+    : model_(&model), precision_(precision), kernels_(&NeuronKernels::active()),
+      size_(size), spiked_(size, 0), recoveryIndex_(model.stateIndex("u"))
+{
+    if (precision_ == Precision::Float) init<float>(size);
+    else init<double>(size);
+}
+
+NeuronPopulation::NeuronPopulation(Model model, std::size_t size, Precision precision)
+    : NeuronPopulation(builtinModel(model), size, precision)
+{}
+
+template <typename T>
+void NeuronPopulation::init(std::size_t size)
+{
+    Storage<T>& s = storage<T>();
+    std::vector<double> initial(model_->stateNames.size());
+    model_->initialState(model_->defaults.data(), initial.data());
+
+    s.state.clear();
+    for (double value : initial) s.state.emplace_back(size, static_cast<T>(value));
+    s.params.clear();
+    for (double value : model_->defaults) s.params.emplace_back(size, static_cast<T>(value));
+    for (std::size_t k = 0; k < model_->derivedNames.size(); ++k) s.params.emplace_back(size, T(0.0));
+    s.i_syn.assign(size, T(0.0));
+    s.i_ext.assign(size, T(0.0));
+    s.i_total.assign(size, T(0.0));
+    s.last_spike_t.assign(size, T(-1e9));
+}
+
+void NeuronPopulation::setParams(std::size_t idx, const std::vector<double>& values)
+{
+    std::vector<double> params = model_->defaults;
+    std::copy_n(values.begin(), std::min(values.size(), params.size()), params.begin());
+    std::vector<double> initial(model_->stateNames.size());
+    model_->initialState(params.data(), initial.data());
+
+    visit([&](auto& s) {
+        using T = typename std::decay_t<decltype(s)>::Scalar;
+        for (std::size_t k = 0; k < params.size(); ++k) s.params[k][idx] = static_cast<T>(params[k]);
+        for (std::size_t k = 0; k < initial.size(); ++k) s.state[k][idx] = static_cast<T>(initial[k]);
+    });
+    preparedStep_ = 0.0;
+}
+
+std::vector<double> NeuronPopulation::params(std::size_t idx) const
+{
+    std::vector<double> values(model_->paramNames.size());
+    visit([&](const auto& s) {
+        for (std::size_t k = 0; k < values.size(); ++k) values[k] = s.params[k][idx];
+    });
+    return values;
+}
+
+void NeuronPopulation::setIntegrateAndFireParams(std::size_t idx, double v_rest, double v_thresh,
+                                                 double tau, double reset_v)
+{
+    setParams(idx, {v_rest, v_thresh, tau, reset_v});
+}
+
+void NeuronPopulation::setIzhikevichParams(std::size_t idx, double a, double b, double c, double d)
+{
+    setParams(idx, {a, b, c, d});
+}
+
+void NeuronPopulation::setIntegrator(int integrator, int substeps)
+{
+    integrator_ = std::clamp(integrator, 0, model_->integratorCount - 1);
+    substeps_ = std::max(substeps, 1);
+}
+
+void NeuronPopulation::setLifIntegrator(LifIntegrator integrator)
+{
+    if (model_ == &ModelRegistry::lif()) setIntegrator(static_cast<int>(integrator), substeps_);
+}
+
+void NeuronPopulation::setIzhikevichIntegrator(IzhikevichIntegrator integrator, int substeps)
+{
+    if (model_ == &ModelRegistry::izhikevich()) setIntegrator(static_cast<int>(integrator), substeps);
+}
+
+void NeuronPopulation::prepare(double dt)
+{
+    const double h = dt / substeps_;
+    if (h == preparedStep_) return;
+    if (precision_ == Precision::Float) prepare<float>(h);
+    else prepare<double>(h);
+    preparedStep_ = h;
+}
+
+template <typename T>
+void NeuronPopulation::prepare(double h)
+{
+    auto prepareParams = model_->ops<T>().prepare;
+    if (!prepareParams) return;
+    T* params[maxModelFields];
+    Storage<T>& s = storage<T>();
+    for (std::size_t k = 0; k < s.params.size(); ++k) params[k] = s.params[k].data();
+    prepareParams(params, size_, h);
+}
+
+void NeuronPopulation::setDelaySlots(std::size_t slots)
+{
+    slots = std::max<std::size_t>(slots, 1);
+    if (precision_ == Precision::Float) resizeRing<float>(slots);
+    else resizeRing<double>(slots);
+    slots_ = slots;
+    slot_ = 0;
+}
+
+template <typename T>
+void NeuronPopulation::resizeRing(std::size_t slots)
+{
+    const std::size_t n = size();
+    const std::size_t old = slots_;
+    std::vector<T>& i_syn = storage<T>().i_syn;
+    std::vector<T> ring(slots * n, T(0.0));
+    for (std::size_t k = 0; k < std::min(old, slots); ++k) {
+        const T* from = i_syn.data() + ((slot_ + k) % old) * n;
+        std::copy(from, from + n, ring.data() + k * n);
+    }
+    i_syn = std::move(ring);
+}
+
+void NeuronPopulation::update(double dt, double i_bias, std::size_t begin, std::size_t end,
+                              std::vector<int>* fired)
+{
+    prepare(dt);
+    if (precision_ == Precision::Float) {
+        update<float>(static_cast<float>(dt), static_cast<float>(i_bias), begin, end, fired);
+    } else {
+        update<double>(dt, i_bias, begin, end, fired);
+    }
+}
+
+template <typename T>
+void NeuronPopulation::update(T dt, T i_bias, std::size_t begin, std::size_t end,
+                              std::vector<int>* fired)
+{
+    Storage<T>& st = storage<T>();
+    T* state[maxModelFields];
+    const T* params[maxModelFields];
+    for (std::size_t k = 0; k < st.state.size(); ++k) state[k] = st.state[k].data();
+    for (std::size_t k = 0; k < st.params.size(); ++k) params[k] = st.params[k].data();
+    ModelArraysT<T> s{state, params, st.i_syn.data() + slot_ * size(), st.i_ext.data(),
+                      st.i_total.data(), st.last_spike_t.data(), spiked_.data()};
+
+    const ModelOpsT<T>& ops = model_->ops<T>();
+    ModelKernelT<T> kernel = ops.specialized(*kernels_, integrator_);
+    if (!kernel) kernel = ops.kernels[integrator_];
+    kernel(s, dt, i_bias, substeps_, begin, end, fired);
+}
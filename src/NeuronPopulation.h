@@ -0,0 +1,368 @@
+/**
+ * @file NeuronPopulation.h
+ * @brief Structure-of-arrays storage and update loop for a population of neurons.
+ * @author Dario Romandini
+ */
+
+#ifndef NEURON_POPULATION_H
+#define NEURON_POPULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "NeuronKernels.h"
+#include "NeuronModel.h"
+
+/**
+ * @class NeuronPopulation
+ * @brief A homogeneous group of neurons stored as contiguous per-field arrays.
+ *
+ * All neurons of a population share one neuron model from the ModelRegistry
+ * (see NeuronModel.h). Every state variable and parameter of the model, the
+ * synaptic/external input and the spike flags live in separate arrays, so
+ * the update is a single tight loop without any per-neuron dispatch. The loop
+ * is the model's kernel from the NeuronKernels set (vectorized for the
+ * running CPU) or, for models without one, the model's portable kernel. The
+ * Neuron classes act as thin views onto one entry.
+ *
+ * State and parameters are stored in double or, to halve memory traffic and
+ * double the SIMD width, in single precision; the choice is made per
+ * population at construction. Per-neuron accessors convert to double.
+ *
+ * Synaptic input is a ring of D per-neuron accumulator slots. An update
+ * consumes the current slot; advanceDelaySlot() then moves to the next one.
+ * Current sent with a delay of d steps lands in slot (current + d) mod D, so
+ * delayed delivery costs the same as immediate delivery.
+ */
+class NeuronPopulation
+{
+public:
+    /** @brief Built-in neuron models (shorthand for their registry descriptors). */
+    enum class Model { IntegrateAndFire, Izhikevich };
+
+    /** @brief Scalar type of the state and parameter arrays. */
+    enum class Precision { Double, Float };
+
+    /**
+     * @brief Construct a population with default model parameters.
+     * @param model Registered neuron model of every member.
+     * @param size Number of neurons.
+     * @param precision Scalar type of the state.
+     */
+    NeuronPopulation(const ModelDescriptor& model, std::size_t size,
+                     Precision precision = Precision::Double);
+
+    /**
+     * @brief Construct a population of a built-in model with default parameters.
+     * @param model Neuron model of every member.
+     * @param size Number of neurons.
+     * @param precision Scalar type of the state.
+     */
+    NeuronPopulation(Model model, std::size_t size, Precision precision = Precision::Double);
+
+    /** @return Neuron model of the population. */
+    const ModelDescriptor& model() const { return *model_; }
+
+    /** @return Scalar type of the state. */
+    Precision precision() const { return precision_; }
+
+    /** @return Number of neurons in the population. */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Set the model parameters of one neuron and reset its state.
+     * @param idx Neuron index.
+     * @param values Parameters in the order of ModelDescriptor::paramNames;
+     *        missing trailing values take the model defaults.
+     */
+    void setParams(std::size_t idx, const std::vector<double>& values);
+
+    /** @return Model parameters of one neuron, in the order of ModelDescriptor::paramNames. */
+    std::vector<double> params(std::size_t idx) const;
+
+    /**
+     * @brief Set the leaky integrate-and-fire parameters of one neuron.
+     * @param idx Neuron index.
+     * @param v_rest Resting potential (mV).
+     * @param v_thresh Spiking threshold (mV).
+     * @param tau Membrane time constant (ms).
+     * @param reset_v Voltage after a spike (mV).
+     */
+    void setIntegrateAndFireParams(std::size_t idx, double v_rest, double v_thresh,
+                                   double tau, double reset_v);
+
+    /**
+     * @brief Set the Izhikevich parameters of one neuron and reset its state.
+     * @param idx Neuron index.
+     * @param a Recovery time constant.
+     * @param b Sensitivity of u to v.
+     * @param c Reset voltage (mV).
+     * @param d Reset increment of u.
+     */
+    void setIzhikevichParams(std::size_t idx, double a, double b, double c, double d);
+
+    /**
+     * @brief Select how the neurons are integrated.
+     *
+     * Every update advances the state by exactly dt, split into @p substeps
+     * equal substeps of the chosen integrator.
+     *
+     * @param integrator Index of the model's integrator (e.g. a LifIntegrator value).
+     * @param substeps Number of substeps per update (at least one).
+     */
+    void setIntegrator(int integrator, int substeps = 1);
+
+    /** @brief setIntegrator() for LIF populations; ignored by other models. */
+    void setLifIntegrator(LifIntegrator integrator);
+
+    /** @brief setIntegrator() for Izhikevich populations; ignored by other models. */
+    void setIzhikevichIntegrator(IzhikevichIntegrator integrator, int substeps = 1);
+
+    /** @return Index of the model's integrator. */
+    int integrator() const { return integrator_; }
+
+    /** @return Number of integration substeps per update. */
+    int substeps() const { return substeps_; }
+
+    /** @return Relative update cost per neuron (see ModelDescriptor::cost). */
+    double cost() const { return model_->cost[integrator_] * substeps_; }
+
+    /**
+     * @brief Precompute the parameters the model derives from the step length.
+     *
+     * For LIF, computes the exact propagators exp(-dt / tau). update() calls
+     * it whenever dt, the substep count or a parameter changed, which is not
+     * safe while other threads update the same population; drivers updating
+     * ranges in parallel call it once per step beforehand, which costs
+     * nothing when up to date.
+     *
+     * @param dt Time step in milliseconds.
+     */
+    void prepare(double dt);
+
+    /**
+     * @brief Select the kernel set used by update() (defaults to NeuronKernels::active()).
+     * @param kernels Kernel set, which must outlive the population.
+     */
+    void setKernels(const NeuronKernels& kernels) { kernels_ = &kernels; }
+
+    /** @return Kernel set used by update(). */
+    const NeuronKernels& kernels() const { return *kernels_; }
+
+    /**
+     * @brief Advance neurons [begin, end) by one time step.
+     *
+     * Consumes the accumulated synaptic and external input of every neuron,
+     * updates the spike flags, and appends the index of each neuron that
+     * fired to @p fired (in ascending order) when it is non-null.
+     *
+     * @param dt Time step in milliseconds.
+     * @param i_bias Input current added to every neuron this step (nA).
+     * @param begin First neuron index.
+     * @param end One past the last neuron index.
+     * @param fired Optional output list of spiking neuron indices.
+     */
+    void update(double dt, double i_bias, std::size_t begin, std::size_t end,
+                std::vector<int>* fired = nullptr);
+
+    /** @brief Add synaptic current to a neuron's input for the next update. */
+    void receiveSynapticCurrent(std::size_t idx, double i_syn) { receiveSynapticCurrent(idx, i_syn, 0); }
+
+    /**
+     * @brief Add synaptic current that arrives @p delay slots after the current one.
+     * @param idx Neuron index.
+     * @param i_syn Synaptic current (nA).
+     * @param delay Delay in steps, 0 <= delay <= delaySlots().
+     */
+    void receiveSynapticCurrent(std::size_t idx, double i_syn, int delay);
+
+    /**
+     * @brief Resize the synaptic input ring.
+     *
+     * Pending input is kept in place (input more than @p slots steps ahead is
+     * dropped when shrinking).
+     *
+     * @param slots Number of slots D (the longest supported delay in steps).
+     */
+    void setDelaySlots(std::size_t slots);
+
+    /** @return Number of synaptic input slots D. */
+    std::size_t delaySlots() const { return slots_; }
+
+    /** @return Slot consumed by the next update. */
+    std::size_t delaySlot() const { return slot_; }
+
+    /** @brief Move to the next input slot; call once per step after delivery. */
+    void advanceDelaySlot() { slot_ = (slot_ + 1) % slots_; }
+
+    /**
+     * @brief Start of the synaptic input ring (delaySlots() × size() values).
+     * @tparam T Scalar type; nullptr unless it matches precision().
+     */
+    template <typename T>
+    T* synapticInputData() { return storage<T>().i_syn.data(); }
+
+    /// @copydoc synapticInputData
+    template <typename T>
+    const T* synapticInputData() const { return storage<T>().i_syn.data(); }
+
+    /** @brief Set the external current of a neuron for the next update. */
+    void setInputCurrent(std::size_t idx, double input);
+
+    /** @return Whether the neuron spiked during the last update. */
+    bool hasSpiked(std::size_t idx) const { return spiked_[idx] != 0; }
+
+    /** @return Last-spike marker of the neuron (0 after a spike, -1e9 initially). */
+    double lastSpikeTime(std::size_t idx) const;
+
+    /** @return Membrane potential of the neuron (mV). */
+    double voltage(std::size_t idx) const;
+
+    /** @return Recovery variable "u" of the neuron (0 for models without one). */
+    double recovery(std::size_t idx) const;
+
+    /** @return State variable @p k (see ModelDescriptor::stateNames) of the neuron. */
+    double stateValue(std::size_t idx, int k) const;
+
+    /**
+     * @return Input current the neuron received in the last update: external,
+     *         synaptic and uniform (bias) input together (nA).
+     */
+    double inputCurrent(std::size_t idx) const;
+
+    // Contiguous state arrays of size() entries, valid until the population
+    // is reassigned; nullptr unless T matches precision(). setDelaySlots()
+    // reallocates the synaptic input ring.
+
+    /** @return Membrane potentials (mV). */
+    template <typename T>
+    const T* voltageData() const { return stateData<T>(0); }
+
+    /** @return State variable @p k (see ModelDescriptor::stateNames). */
+    template <typename T>
+    const T* stateData(int k) const
+    {
+        const auto& fields = storage<T>().state;
+        return k >= 0 && static_cast<std::size_t>(k) < fields.size() ? fields[k].data() : nullptr;
+    }
+
+    /** @return Recovery variables "u"; nullptr for models without one. */
+    template <typename T>
+    const T* recoveryData() const { return stateData<T>(recoveryIndex_); }
+
+    /** @return Input currents received in the last update (see inputCurrent()). */
+    template <typename T>
+    const T* inputCurrentData() const { return storage<T>().i_total.data(); }
+
+    /** @return Spike flags of the last update (0 or 1). */
+    const std::uint8_t* spikeFlagData() const { return spiked_.data(); }
+
+private:
+    /** @brief State and parameter arrays in one scalar type. */
+    template <typename T>
+    struct Storage
+    {
+        using Scalar = T;
+
+        std::vector<std::vector<T>> state;   ///< One array per model state variable
+        std::vector<std::vector<T>> params;  ///< One array per model parameter, then per derived field
+        std::vector<T> i_syn;                ///< Synaptic input ring, slot-major (nA)
+        std::vector<T> i_ext;                ///< External input current (nA)
+        std::vector<T> i_total;              ///< Total input current of the last update (nA)
+        std::vector<T> last_spike_t;         ///< Last-spike marker
+    };
+
+    template <typename T>
+    Storage<T>& storage()
+    {
+        if constexpr (std::is_same_v<T, float>) return f_;
+        else return d_;
+    }
+
+    template <typename T>
+    const Storage<T>& storage() const
+    {
+        if constexpr (std::is_same_v<T, float>) return f_;
+        else return d_;
+    }
+
+    /** @brief Call fn with the Storage of the population's precision. */
+    template <typename Fn>
+    decltype(auto) visit(Fn&& fn) const
+    {
+        return precision_ == Precision::Float ? fn(f_) : fn(d_);
+    }
+
+    template <typename Fn>
+    decltype(auto) visit(Fn&& fn)
+    {
+        return precision_ == Precision::Float ? fn(f_) : fn(d_);
+    }
+
+    template <typename T>
+    void init(std::size_t size);
+
+    template <typename T>
+    void prepare(double h);
+
+    template <typename T>
+    void update(T dt, T i_bias, std::size_t begin, std::size_t end, std::vector<int>* fired);
+
+    template <typename T>
+    void resizeRing(std::size_t slots);
+
+    const ModelDescriptor* model_;
+    Precision precision_;
+    const NeuronKernels* kernels_;
+    std::size_t size_;
+
+    Storage<double> d_;                 ///< Storage of double populations
+    Storage<float> f_;                  ///< Storage of float populations
+    std::vector<std::uint8_t> spiked_;  ///< Spike flag of the last update
+    std::size_t slots_ = 1;             ///< Number of input slots D
+    std::size_t slot_ = 0;              ///< Input slot consumed by the next update
+    int recoveryIndex_ = -1;            ///< State index of "u", -1 if none
+    int integrator_ = 0;                ///< Index of the model's integrator
+    int substeps_ = 1;                  ///< Integration substeps per update
+    double preparedStep_ = 0.0;         ///< Substep prepare() last ran for (0: stale)
+};
+
+inline void NeuronPopulation::receiveSynapticCurrent(std::size_t idx, double i_syn, int delay)
+{
+    const std::size_t k = ((slot_ + delay) % slots_) * size_ + idx;
+    visit([&](auto& s) { s.i_syn[k] += static_cast<typename std::decay_t<decltype(s)>::Scalar>(i_syn); });
+}
+
+inline void NeuronPopulation::setInputCurrent(std::size_t idx, double input)
+{
+    visit([&](auto& s) { s.i_ext[idx] = static_cast<typename std::decay_t<decltype(s)>::Scalar>(input); });
+}
+
+inline double NeuronPopulation::lastSpikeTime(std::size_t idx) const
+{
+    return visit([&](const auto& s) -> double { return s.last_spike_t[idx]; });
+}
+
+inline double NeuronPopulation::voltage(std::size_t idx) const
+{
+    return visit([&](const auto& s) -> double { return s.state[0][idx]; });
+}
+
+inline double NeuronPopulation::recovery(std::size_t idx) const
+{
+    return recoveryIndex_ < 0 ? 0.0 : stateValue(idx, recoveryIndex_);
+}
+
+inline double NeuronPopulation::stateValue(std::size_t idx, int k) const
+{
+    return visit([&](const auto& s) -> double { return s.state[k][idx]; });
+}
+
+inline double NeuronPopulation::inputCurrent(std::size_t idx) const
+{
+    return visit([&](const auto& s) -> double { return s.i_total[idx]; });
+}
+
+#endif // NEURON_POPULATION_H
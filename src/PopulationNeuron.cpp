@@ -0,0 +1,41 @@
+/**
+ * @file PopulationNeuron.cpp
+ * @brief Implements the model-agnostic neuron view.
+ * @author Dario Romandini
+ */
+
+#include "PopulationNeuron.h"
+
+PopulationNeuron::PopulationNeuron(NeuronPopulation& population, std::size_t index)
+    : population_(&population), index_(index)
+{}
+
+void PopulationNeuron::update(double dt)
+{
+    population_->update(dt, 0.0, index_, index_ + 1);
+}
+
+void PopulationNeuron::receiveSynapticCurrent(double i_syn)
+{
+    population_->receiveSynapticCurrent(index_, i_syn);
+}
+
+void PopulationNeuron::setInputCurrent(double input)
+{
+    population_->setInputCurrent(index_, input);
+}
+
+bool PopulationNeuron::hasSpiked() const
+{
+    return population_->hasSpiked(index_);
+}
+
+double PopulationNeuron::lastSpikeTime() const
+{
+    return population_->lastSpikeTime(index_);
+}
+
+double PopulationNeuron::getVoltage() const
+{
+    return population_->voltage(index_);
+}
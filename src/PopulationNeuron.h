@@ -0,0 +1,64 @@
+/**
+ * @file PopulationNeuron.h
+ * @brief Model-agnostic neuron view onto a NeuronPopulation entry.
+ * @author Dario Romandini
+ */
+
+#ifndef POPULATION_NEURON_H
+#define POPULATION_NEURON_H
+
+#include "Neuron.h"
+#include "NeuronPopulation.h"
+#include <cstddef>
+
+/**
+ * @class PopulationNeuron
+ * @brief Neuron interface onto one entry of a population of any model.
+ *
+ * Used by Simulation for models registered at runtime, which have no
+ * dedicated neuron class. The view only forwards to the population and
+ * never owns storage.
+ */
+class PopulationNeuron : public Neuron
+{
+public:
+    /**
+     * @brief Construct a view onto an existing population entry.
+     * @param population Population holding the neuron state.
+     * @param index Index of the neuron within the population.
+     */
+    PopulationNeuron(NeuronPopulation& population, std::size_t index);
+
+    /**
+     * @brief Update the neuron's state by one time step.
+     * @param dt Time step in milliseconds.
+     */
+    void update(double dt) override;
+
+    /**
+     * @brief Receive synaptic current from connected neurons.
+     * @param i_syn Synaptic current (nA).
+     */
+    void receiveSynapticCurrent(double i_syn) override;
+
+    /** @return True if the neuron spiked during the last update. */
+    bool hasSpiked() const override;
+
+    /** @return Time of the last spike (ms). */
+    double lastSpikeTime() const override;
+
+    /** @return Membrane voltage (mV). */
+    double getVoltage() const override;
+
+    /**
+     * @brief Set external input current to be applied this time step.
+     * @param input External current (nA).
+     */
+    void setInputCurrent(double input) override;
+
+private:
+    NeuronPopulation* population_;  ///< Population holding the state
+    std::size_t index_;             ///< Index within the population
+};
+
+#endif // POPULATION_NEURON_H
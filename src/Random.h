@@ -0,0 +1,61 @@
+/**
+ * @file Random.h
+ * @brief Counter-based random streams for reproducible parallel generation.
+ * @author Dario Romandini
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @class RandomStream
+ * @brief SplitMix64 generator keyed on a (seed, stream) pair.
+ *
+ * Every stream is fully determined by its key, so work split by row (one
+ * stream per source neuron) draws the same numbers no matter which thread
+ * handles the row, or whether the row is generated again later.
+ */
+class RandomStream
+{
+public:
+    /**
+     * @brief Construct the stream @p stream of generator @p seed.
+     * @param seed User seed.
+     * @param stream Stream index, e.g. the source neuron.
+     */
+    RandomStream(std::uint64_t seed, std::uint64_t stream)
+        : state_(mix(seed ^ mix(stream + 0x9e3779b97f4a7c15ULL)))
+    {}
+
+    /** @return Next 64 random bits. */
+    std::uint64_t next()
+    {
+        state_ += 0x9e3779b97f4a7c15ULL;
+        return mix(state_);
+    }
+
+    /** @return Uniform double in [0, 1). */
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    /** @return Standard normal deviate (Box-Muller, two uniforms per call). */
+    double normal()
+    {
+        double r = std::sqrt(-2.0 * std::log1p(-uniform()));
+        return r * std::cos(6.283185307179586 * uniform());
+    }
+
+private:
+    static std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t state_;
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,123 @@
+/**
+ * @file RandomProjection.h
+ * @brief Fixed-probability connectivity that regenerates its rows from a seed.
+ * @author Dario Romandini
+ */
+
+#ifndef RANDOM_PROJECTION_H
+#define RANDOM_PROJECTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "Random.h"
+
+/**
+ * @class RandomProjection
+ * @brief Connects sources to targets independently with probability p, without storing synapses.
+ *
+ * Every source in [srcBegin, srcEnd) connects to every target in
+ * [dstBegin, dstEnd) other than itself with probability p, with one weight
+ * and delay for the whole projection. The targets are split into blocks of
+ * about 64 expected synapses; those of row i in block b are drawn from their
+ * own stream, keyed on (i, b), as geometric gaps between successive
+ * candidates. So they come out in ascending order, any row can be
+ * regenerated on its own, in O(fan-out), e.g. when its neuron spikes, and a
+ * delivery worker owning a range of targets starts at the block holding it
+ * instead of at the start of the row. Simulation::connectRandom stores the
+ * same rows, so a stored and a procedural build with one seed have the same
+ * synapses.
+ */
+class RandomProjection
+{
+public:
+    /**
+     * @brief Describe a projection.
+     * @param seed Seed of the row streams.
+     * @param probability Connection probability; values >= 1 connect all pairs.
+     * @param weight Weight of every synapse (nA).
+     * @param delay Delay of every synapse in steps (>= 1).
+     * @param srcBegin First source neuron.
+     * @param srcEnd One past the last source neuron.
+     * @param dstBegin First target neuron.
+     * @param dstEnd One past the last target neuron.
+     */
+    RandomProjection(std::uint64_t seed, double probability, double weight, int delay,
+                     int srcBegin, int srcEnd, int dstBegin, int dstEnd)
+        : seed_(seed), probability_(probability), weight_(weight), delay_(delay),
+          srcBegin_(srcBegin), srcEnd_(srcEnd), dstBegin_(dstBegin), dstEnd_(dstEnd),
+          logQ_(std::log1p(-std::min(probability, 1.0))),
+          block_(probability >= 1.0
+                     ? 64 : static_cast<long long>(std::min(std::ceil(64.0 / probability), 0x1p30)))
+    {}
+
+    /**
+     * @brief Call fn(target) for the targets of row @p src in [first, last), in ascending order.
+     *
+     * Only the blocks overlapping the range are drawn, so the cost grows
+     * with the range, plus at most two partial blocks.
+     *
+     * @param src Source neuron in [srcBegin, srcEnd).
+     * @param first First target visited.
+     * @param last One past the last target visited.
+     * @param fn Callable taking the target (int).
+     */
+    template <typename Fn>
+    void forEachTarget(int src, int first, int last, Fn&& fn) const
+    {
+        const long long begin = std::max(dstBegin_, first);
+        const long long end = std::min(dstEnd_, last);
+        for (long long b = (begin - dstBegin_) / block_; dstBegin_ + b * block_ < end; ++b) {
+            RandomStream rng(seed_, static_cast<std::uint64_t>(src) << 32 | static_cast<std::uint64_t>(b));
+            const long long stop = std::min(dstBegin_ + (b + 1) * block_, end);
+            for (long long j = dstBegin_ + b * block_ - 1;;) {
+                double skip = probability_ >= 1.0 ? 0.0 : std::floor(std::log1p(-rng.uniform()) / logQ_);
+                if (skip >= static_cast<double>(stop - j - 1)) break;
+                j += 1 + static_cast<long long>(skip);
+                if (j != src && j >= begin) fn(static_cast<int>(j));
+            }
+        }
+    }
+
+    /** @brief Call fn(target) for all targets of row @p src, in ascending order. */
+    template <typename Fn>
+    void forEachTarget(int src, Fn&& fn) const
+    {
+        forEachTarget(src, dstBegin_, dstEnd_, fn);
+    }
+
+    /** @return Whether neuron @p src is a source of the projection. */
+    bool hasSource(int src) const { return src >= srcBegin_ && src < srcEnd_; }
+
+    /** @return Weight of every synapse (nA). */
+    double weight() const { return weight_; }
+
+    /** @return Delay of every synapse (steps). */
+    int delay() const { return delay_; }
+
+    /** @return First source neuron. */
+    int srcBegin() const { return srcBegin_; }
+
+    /** @return One past the last source neuron. */
+    int srcEnd() const { return srcEnd_; }
+
+    /** @return Number of synapses, as counted by setSynapseCount(). */
+    std::size_t synapseCount() const { return synapseCount_; }
+
+    /** @brief Record the number of synapses, counted once by the creator. */
+    void setSynapseCount(std::size_t count) { synapseCount_ = count; }
+
+private:
+    std::uint64_t seed_;        ///< Seed of the row streams
+    double probability_;        ///< Connection probability
+    double weight_;             ///< Weight of every synapse (nA)
+    int delay_;                 ///< Delay of every synapse (steps)
+    int srcBegin_, srcEnd_;     ///< Source neurons
+    int dstBegin_, dstEnd_;     ///< Target neurons
+    double logQ_;               ///< log(1 - p), the scale of the geometric gaps
+    long long block_;           ///< Targets per stream, about 64 expected synapses
+    std::size_t synapseCount_ = 0;  ///< Number of synapses
+};
+
+#endif // RANDOM_PROJECTION_H
@@ -31,7 +31,6 @@ void RasterPlotWidget::paintEvent(QPaintEvent*)
 
     if (!simulation_) return;
 
-    const auto& events = simulation_->spikeEvents();
     double t1 = simulation_->currentTime();
     double t0 = std::max(0.0, t1 - 200.0);  // Show 200 ms window
     int w = width(), h = height();
@@ -39,13 +38,13 @@ void RasterPlotWidget::paintEvent(QPaintEvent*)
 
     if (N == 0 || t1 <= t0) return;
 
+    const double dt = simulation_->dt();
     p.setPen(QPen(Qt::white, 1));
-    for (const auto& ev : events) {
-        double t = ev.first;
-        int idx = ev.second;
-        if (t < t0 || t > t1) continue;
-        double x = (t - t0) / (t1 - t0) * w;
-        double y = (idx + 0.5) / N * h;
-        p.drawPoint(QPointF(x, y));
-    }
+    simulation_->spikeStore().forEach(simulation_->windowStart(200.0), simulation_->currentStep(),
+        [&](const SpikeEvent& ev) {
+            double t = ev.step * dt;
+            double x = (t - t0) / (t1 - t0) * w;
+            double y = (ev.neuron + 0.5) / N * h;
+            p.drawPoint(QPointF(x, y));
+        });
 }
@@ -6,114 +6,734 @@
 
 #include "Simulation.h"
 #include "IntegrateAndFireNeuron.h"
+#include "IzhikevichNeuron.h"
+#include "ModelRegistry.h"
+#include "PopulationNeuron.h"
+#include "RandomProjection.h"
 #include <random>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
 
-Simulation::Simulation(int nx, int ny, double dt)
-    : nx_(nx), ny_(ny), dt_(dt), currentTime_(0.0)
+Simulation::Simulation(int nx, int ny, double dt, int threads,
+                       NeuronPopulation::Precision precision)
+    : nx_(nx), ny_(ny), dt_(dt), precision_(precision), step_(0),
+      layout_{{"neurons", &ModelRegistry::lif(), nx * ny, {}, 0, 1}},
+      connectivity_(std::make_shared<SynapseMatrix>(0))
 {
+    setThreadCount(threads);
     initializeNeurons();
 }
 
 void Simulation::initializeNeurons()
 {
-    neurons_.clear();
-    neurons_.reserve(nx_ * ny_);
-    for (int i = 0; i < nx_ * ny_; ++i) {
-        neurons_.emplace_back(std::make_unique<IntegrateAndFireNeuron>());
+    requireUnpinnedStorage();
+    populations_.clear();
+    offsets_.assign(1, 0);
+    for (const PopulationConfig& config : layout_) {
+        NeuronPopulation& pop = populations_.emplace_back(
+            config.model ? *config.model : ModelRegistry::lif(), config.size, precision_);
+        if (!config.params.empty()) {
+            for (std::size_t i = 0; i < pop.size(); ++i) pop.setParams(i, config.params);
+        }
+        pop.setIntegrator(config.integrator, config.substeps);
+        offsets_.push_back(offsets_.back() + config.size);
     }
+    const int N = offsets_.back();
+    views_.clear();
+    views_.resize(N);
+    fired_.clear();
 
-    synapses_.clear();
-    events_.clear();
-    currentTime_ = 0.0;
+    auto connectivity = std::make_shared<SynapseMatrix>(N);
+    connectivity->setTargetEncoding(targetEncoding_);
+    connectivity->setWeightEncoding(weightEncoding_);
+    connectivity_ = std::move(connectivity);
+    if (stdp_) {
+        // Restart the traces; STDP ends with the population it applied to.
+        const StdpRule rule = stdp_->rule();
+        const bool kept = stdpSource_.empty() ||
+            std::any_of(layout_.begin(), layout_.end(),
+                        [&](const PopulationConfig& config) { return config.name == stdpSource_; });
+        if (kept) enableStdp(rule, stdpSource_);
+        else disableStdp();
+    }
+    spikes_.clear();
+    step_ = 0;
+    for (auto& tracker : rateTrackers_) {
+        tracker = SpikeRateTracker(N, tracker.windowSteps());
+    }
+    for (auto& monitor : stateMonitors_) monitor->clear();
+    for (auto& monitor : spikeMonitors_) monitor->clear();
 }
 
-void Simulation::connectRandom(double probability, double weight)
+void Simulation::setPopulations(std::vector<PopulationConfig> populations)
 {
-    std::mt19937 gen{std::random_device{}()};
-    std::uniform_real_distribution<> dist(0.0, 1.0);
-
-    int N = neuronCount();
-    for (int i = 0; i < N; ++i) {
-        for (int j = 0; j < N; ++j) {
-            if (i != j && dist(gen) < probability) {
-                synapses_.emplace_back(i, j, weight);
+    requireUnpinnedStorage();
+    int total = 0;
+    for (std::size_t k = 0; k < populations.size(); ++k) {
+        const PopulationConfig& config = populations[k];
+        if (config.name.empty()) throw std::invalid_argument("population without a name");
+        for (std::size_t j = 0; j < k; ++j) {
+            if (populations[j].name == config.name) {
+                throw std::invalid_argument("duplicate population name: " + config.name);
             }
         }
+        if (config.size < 0) throw std::invalid_argument("negative size of population " + config.name);
+        total += config.size;
+    }
+    if (total != nx_ * ny_) {
+        throw std::invalid_argument("population sizes add up to " + std::to_string(total) +
+                                    " neurons instead of " + std::to_string(nx_ * ny_));
+    }
+
+    layout_ = std::move(populations);
+    initializeNeurons();
+}
+
+std::shared_ptr<const void> Simulation::pinStorage() const
+{
+    std::shared_ptr<const void> pin = storagePin_.lock();
+    if (!pin) {
+        pin = std::make_shared<int>(0);
+        storagePin_ = pin;
+    }
+    return pin;
+}
+
+void Simulation::requireUnpinnedStorage() const
+{
+    if (!storagePin_.expired()) {
+        throw std::logic_error("population storage is in use by views; release them first");
     }
 }
 
-void Simulation::connectByProximity(double radius, double weight)
+const std::vector<PopulationConfig>& Simulation::populations() const
 {
-    for (int y1 = 0; y1 < ny_; ++y1) {
-        for (int x1 = 0; x1 < nx_; ++x1) {
-            int i = index(x1, y1);
-            for (int y2 = 0; y2 < ny_; ++y2) {
-                for (int x2 = 0; x2 < nx_; ++x2) {
-                    int j = index(x2, y2);
-                    if (i != j) {
-                        double dx = x1 - x2;
-                        double dy = y1 - y2;
-                        if (std::sqrt(dx * dx + dy * dy) <= radius) {
-                            synapses_.emplace_back(i, j, weight);
-                        }
-                    }
+    return layout_;
+}
+
+int Simulation::populationCount() const
+{
+    return static_cast<int>(populations_.size());
+}
+
+int Simulation::populationIndex(const std::string& name) const
+{
+    for (std::size_t k = 0; k < layout_.size(); ++k) {
+        if (layout_[k].name == name) return static_cast<int>(k);
+    }
+    throw std::invalid_argument("unknown population: " + name);
+}
+
+std::pair<int, int> Simulation::populationRange(int k) const
+{
+    return {offsets_.at(k), offsets_.at(k + 1)};
+}
+
+int Simulation::populationOf(int idx) const
+{
+    auto it = std::upper_bound(offsets_.begin() + 1, offsets_.end() - 1, idx);
+    return static_cast<int>(it - offsets_.begin()) - 1;
+}
+
+std::pair<int, int> Simulation::rangeOf(const std::string& name) const
+{
+    if (name.empty()) return {0, neuronCount()};
+    return populationRange(populationIndex(name));
+}
+
+void Simulation::connectRandom(double probability, double weight, double delay,
+                               std::optional<std::uint64_t> seed,
+                               const std::string& source, const std::string& target)
+{
+    if (!(probability > 0.0)) return;
+    if (procedural_ && stdp_) throw std::logic_error("STDP needs stored synapses");
+
+    const auto [srcBegin, srcEnd] = rangeOf(source);
+    const auto [dstBegin, dstEnd] = rangeOf(target);
+    const std::uint64_t key = seed ? *seed : (std::uint64_t{std::random_device{}()} << 32 |
+                                              std::random_device{}());
+    const int N = neuronCount();
+    RandomProjection projection(key, probability, weight, delaySteps(delay),
+                                srcBegin, srcEnd, dstBegin, dstEnd);
+
+    const int T = pool_->size();
+    SynapseRows rows;
+    rows.offsets.assign(N + 1, 0);
+
+    // Pass 1: row sizes. Pass 2 replays the same streams into the rows; a
+    // procedural projection keeps only the total.
+    pool_->run([&](int w) {
+        auto [begin, end] = ThreadPool::split(srcEnd - srcBegin, T, w);
+        for (int i = srcBegin + static_cast<int>(begin); i < srcBegin + static_cast<int>(end); ++i) {
+            std::size_t count = 0;
+            projection.forEachTarget(i, [&](int) { ++count; });
+            rows.offsets[i + 1] = count;
+        }
+    });
+    for (std::size_t i = 1; i < rows.offsets.size(); ++i) {
+        rows.offsets[i] += rows.offsets[i - 1];
+    }
+
+    const std::size_t total = rows.offsets.back();
+    if (procedural_) {
+        projection.setSynapseCount(total);
+        ownConnectivity().addProjection(projection);
+        connectivityChanged();
+        return;
+    }
+
+    rows.targets.resize(total);
+    rows.weights.assign(total, weight);
+    rows.delays.assign(total, static_cast<std::uint16_t>(projection.delay()));
+    pool_->run([&](int w) {
+        auto [begin, end] = ThreadPool::split(srcEnd - srcBegin, T, w);
+        for (int i = srcBegin + static_cast<int>(begin); i < srcBegin + static_cast<int>(end); ++i) {
+            std::size_t k = rows.offsets[i];
+            projection.forEachTarget(i, [&](int t) { rows.targets[k++] = t; });
+        }
+    });
+
+    addSynapses(std::move(rows));
+}
+
+void Simulation::connectByProximity(double radius, double weight,
+                                    double delay, double delayPerUnit, bool wrap,
+                                    const std::string& source, const std::string& target)
+{
+    if (!(radius >= 0.0)) {
+        throw std::invalid_argument("connection radius must be non-negative");
+    }
+    const auto [srcBegin, srcEnd] = rangeOf(source);
+    const auto [dstBegin, dstEnd] = rangeOf(target);
+    auto isSource = [&](int i) { return i >= srcBegin && i < srcEnd; };
+    auto isTarget = [&](int t) { return t >= dstBegin && t < dstEnd; };
+    const bool allTargets = dstBegin == 0 && dstEnd == neuronCount();
+
+    // Stencil of in-radius offsets in ascending (dy, dx) order. With wrapping,
+    // offsets are limited to one grid period so every target appears once.
+    struct Offset { int dx, dy; std::uint16_t delay; };
+    const int r = static_cast<int>(std::min<double>(std::floor(radius), std::max(nx_, ny_)));
+    int dxMin = -r, dxMax = r, dyMin = -r, dyMax = r;
+    if (wrap) {
+        dxMin = std::max(dxMin, -(nx_ - 1) / 2);
+        dxMax = std::min(dxMax, nx_ / 2);
+        dyMin = std::max(dyMin, -(ny_ - 1) / 2);
+        dyMax = std::min(dyMax, ny_ / 2);
+    }
+    std::vector<Offset> stencil;
+    for (int dy = dyMin; dy <= dyMax; ++dy) {
+        for (int dx = dxMin; dx <= dxMax; ++dx) {
+            double distance = std::sqrt(static_cast<double>(dx * dx + dy * dy));
+            if ((dx != 0 || dy != 0) && distance <= radius) {
+                auto steps = static_cast<std::uint16_t>(delaySteps(delay + distance * delayPerUnit));
+                stencil.push_back({dx, dy, steps});
+            }
+        }
+    }
+    if (stencil.empty()) return;
+
+    // Calls fn(target, stencil entry) for the synapses of row (x, y), by target.
+    auto forEachTarget = [&](int x, int y, auto&& fn) {
+        if (!isSource(index(x, y))) return;
+        if (!wrap) {
+            for (const Offset& o : stencil) {
+                int tx = x + o.dx, ty = y + o.dy;
+                if (tx >= 0 && tx < nx_ && ty >= 0 && ty < ny_ && isTarget(index(tx, ty))) {
+                    fn(index(tx, ty), o);
+                }
+            }
+            return;
+        }
+        thread_local std::vector<std::pair<int, const Offset*>> row;
+        row.clear();
+        for (const Offset& o : stencil) {
+            int tx = (x + o.dx + nx_) % nx_, ty = (y + o.dy + ny_) % ny_;
+            if (isTarget(index(tx, ty))) row.emplace_back(index(tx, ty), &o);
+        }
+        std::sort(row.begin(), row.end(),
+                  [](const auto& l, const auto& r) { return l.first < r.first; });
+        for (const auto& [t, o] : row) fn(t, *o);
+    };
+
+    const int T = pool_->size();
+    SynapseRows rows;
+    rows.offsets.assign(neuronCount() + 1, 0);
+
+    // Pass 1: row sizes (the full stencil, minus clipping at the borders and
+    // neurons outside the source and target populations).
+    pool_->run([&](int w) {
+        auto [yBegin, yEnd] = ThreadPool::split(ny_, T, w);
+        for (int y = static_cast<int>(yBegin); y < static_cast<int>(yEnd); ++y) {
+            for (int x = 0; x < nx_; ++x) {
+                std::size_t count = isSource(index(x, y)) ? stencil.size() : 0;
+                if (!wrap || !allTargets) {
+                    count = 0;
+                    forEachTarget(x, y, [&](int, const Offset&) { ++count; });
                 }
+                rows.offsets[index(x, y) + 1] = count;
             }
         }
+    });
+    for (std::size_t i = 1; i < rows.offsets.size(); ++i) {
+        rows.offsets[i] += rows.offsets[i - 1];
     }
+
+    // Pass 2: fill the preallocated rows.
+    const std::size_t total = rows.offsets.back();
+    rows.targets.resize(total);
+    rows.weights.assign(total, weight);
+    rows.delays.resize(total);
+    pool_->run([&](int w) {
+        auto [yBegin, yEnd] = ThreadPool::split(ny_, T, w);
+        for (int y = static_cast<int>(yBegin); y < static_cast<int>(yEnd); ++y) {
+            for (int x = 0; x < nx_; ++x) {
+                std::size_t k = rows.offsets[index(x, y)];
+                forEachTarget(x, y, [&](int t, const Offset& o) {
+                    rows.targets[k] = t;
+                    rows.delays[k] = o.delay;
+                    ++k;
+                });
+            }
+        }
+    });
+
+    addSynapses(std::move(rows));
+}
+
+int Simulation::delaySteps(double delay) const
+{
+    long steps = std::lround(delay / dt_);
+    return static_cast<int>(std::clamp(steps, 1L, 65535L));
+}
+
+void Simulation::addSynapses(const std::vector<Synapse>& synapses)
+{
+    ownConnectivity().append(synapses);
+    connectivityChanged();
+}
+
+void Simulation::addSynapses(SynapseRows rows)
+{
+    ownConnectivity().append(std::move(rows));
+    connectivityChanged();
+}
+
+void Simulation::connectivityChanged()
+{
+    reserveDelaySlots(connectivity_->maxDelay());
+    if (stdp_) {
+        const auto [begin, end] = rangeOf(stdpSource_);
+        stdp_->index(*connectivity_, begin, end);
+    }
+}
+
+void Simulation::reserveDelaySlots(std::size_t slots)
+{
+    // The populations are resized and advanced together, so they share one
+    // ring length and one current slot.
+    if (populations_.empty() || slots <= populations_.front().delaySlots()) return;
+    for (NeuronPopulation& pop : populations_) pop.setDelaySlots(slots);
+}
+
+SynapseMatrix& Simulation::ownConnectivity()
+{
+    // Copy on write: a matrix shared with other simulations is never modified.
+    if (connectivity_.use_count() > 1) {
+        connectivity_ = std::make_shared<SynapseMatrix>(*connectivity_);
+    }
+    return const_cast<SynapseMatrix&>(*connectivity_);
 }
 
 void Simulation::step()
 {
-    for (auto& neuron : neurons_) {
-        neuron->receiveSynapticCurrent(globalInputCurrent_);
-        neuron->update(dt_);
+    if (pool_->size() > 1) {
+        stepParallel();
+    } else {
+        fired_.clear();
+        updateRange(0, neuronCount(), fired_);
+        deliverRange(0, neuronCount());
+        if (stdp_) stdp_->apply(step_, fired_, ownConnectivity(), 0, neuronCount());
     }
+    if (stdp_) stdp_->record(step_, fired_);
+
+    for (NeuronPopulation& pop : populations_) pop.advanceDelaySlot();
 
-    for (auto& syn : synapses_) {
-        syn.propagate(neurons_);
+    spikes_.record(step_, fired_);
+    for (auto& tracker : rateTrackers_) {
+        tracker.record(fired_);
+    }
+    for (auto& monitor : stateMonitors_) {
+        monitor->record(step_, populations_, offsets_);
     }
+    for (auto& monitor : spikeMonitors_) {
+        monitor->record(step_, fired_);
+    }
+    ++step_;
+}
+
+int Simulation::run(int steps, const RunLimits& limits)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    std::uint64_t spikes = 0;
+
+    int done = 0;
+    while (done < steps) {
+        step();
+        ++done;
+        spikes += fired_.size();
+        if (limits.maxSpikes > 0 && spikes >= limits.maxSpikes) break;
+        if (limits.maxWallSeconds > 0.0 &&
+            std::chrono::duration<double>(Clock::now() - start).count() >= limits.maxWallSeconds) {
+            break;
+        }
+    }
+    return done;
+}
+
+int Simulation::runFor(double ms, const RunLimits& limits)
+{
+    return run(static_cast<int>(std::lround(std::max(0.0, ms) / dt_)), limits);
+}
 
-    for (int i = 0; i < neuronCount(); ++i) {
-        if (neurons_[i]->hasSpiked()) {
-            events_.emplace_back(currentTime_, i);
+void Simulation::stepParallel()
+{
+    const int T = pool_->size();
+    const std::size_t N = neuronCount();
+
+    // Phase 1: each worker updates a contiguous neuron range of about equal
+    // cost. Boundaries fall on multiples of 64 neurons from the start of a
+    // population, keeping vector blocks whole.
+    double total = 0.0;
+    for (NeuronPopulation& pop : populations_) {
+        pop.prepare(dt_);
+        total += pop.cost() * pop.size();
+    }
+    std::vector<int> bounds(T + 1, static_cast<int>(N));
+    bounds[0] = 0;
+    std::size_t k = 0;
+    double before = 0.0;  // cost of the populations preceding k
+    for (int w = 1; w < T; ++w) {
+        const double share = total * w / T;
+        while (k + 1 < populations_.size() &&
+               before + populations_[k].cost() * populations_[k].size() <= share) {
+            before += populations_[k].cost() * populations_[k].size();
+            ++k;
         }
+        const std::size_t n = populations_[k].size();
+        auto local = static_cast<std::size_t>(std::lround((share - before) / populations_[k].cost() / 64.0)) * 64;
+        bounds[w] = std::max(bounds[w - 1], offsets_[k] + static_cast<int>(std::min(local, n)));
     }
+    pool_->run([&](int w) {
+        workerFired_[w].clear();
+        updateRange(bounds[w], bounds[w + 1], workerFired_[w]);
+    });
 
-    currentTime_ += dt_;
+    fired_.clear();
+    for (const auto& fired : workerFired_) {
+        fired_.insert(fired_.end(), fired.begin(), fired.end());
+    }
+
+    // Phase 2: each worker delivers all spikes to its own range of targets,
+    // then applies plasticity to the synapses onto that range.
+    SynapseMatrix* plastic = stdp_ ? &ownConnectivity() : nullptr;
+    pool_->run([&](int w) {
+        auto [begin, end] = ThreadPool::split(N, T, w, 64);
+        deliverRange(static_cast<int>(begin), static_cast<int>(end));
+        if (plastic) stdp_->apply(step_, fired_, *plastic, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+void Simulation::updateRange(int begin, int end, std::vector<int>& fired)
+{
+    for (std::size_t k = 0; k < populations_.size(); ++k) {
+        const int first = std::max(begin, offsets_[k]);
+        const int last = std::min(end, offsets_[k + 1]);
+        if (first >= last) continue;
+
+        // Populations report their own indices; shift them to neuron indices.
+        const std::size_t from = fired.size();
+        populations_[k].update(dt_, globalInputCurrent_, first - offsets_[k], last - offsets_[k],
+                               &fired);
+        for (std::size_t j = from; j < fired.size(); ++j) fired[j] += offsets_[k];
+    }
+}
+
+void Simulation::deliverRange(int begin, int end)
+{
+    for (std::size_t k = 0; k < populations_.size(); ++k) {
+        const int first = std::max(begin, offsets_[k]);
+        const int last = std::min(end, offsets_[k + 1]);
+        if (first < last) connectivity_->deliver(fired_, populations_[k], first, last, offsets_[k]);
+    }
+}
+
+void Simulation::setThreadCount(int threads)
+{
+    pool_ = std::make_unique<ThreadPool>(threads);
+    workerFired_.assign(pool_->size(), {});
 }
 
-int Simulation::neuronCount() const { return static_cast<int>(neurons_.size()); }
+void Simulation::enableStdp(const StdpRule& rule, const std::string& source)
+{
+    if (weightEncoding_ != SynapseMatrix::WeightEncoding::Double) {
+        throw std::logic_error("STDP needs double weights");
+    }
+    if (!connectivity_->projections().empty()) throw std::logic_error("STDP needs stored synapses");
+    const auto [begin, end] = rangeOf(source);
+    stdp_ = std::make_unique<Stdp>(rule, dt_, neuronCount());
+    stdpSource_ = source;
+    stdp_->index(*connectivity_, begin, end);
+}
+
+void Simulation::disableStdp()
+{
+    stdp_.reset();
+    stdpSource_.clear();
+}
+
+const Stdp* Simulation::stdp() const
+{
+    return stdp_.get();
+}
+
+int Simulation::threadCount() const
+{
+    return pool_->size();
+}
+
+int Simulation::neuronCount() const { return offsets_.back(); }
 int Simulation::nx() const { return nx_; }
 int Simulation::ny() const { return ny_; }
-double Simulation::currentTime() const { return currentTime_; }
+double Simulation::currentTime() const { return step_ * dt_; }
+std::uint32_t Simulation::currentStep() const { return step_; }
+double Simulation::dt() const { return dt_; }
+NeuronPopulation::Precision Simulation::precision() const { return precision_; }
+
+void Simulation::setLifIntegrator(LifIntegrator integrator)
+{
+    lifIntegrator_ = integrator;
+    for (std::size_t k = 0; k < layout_.size(); ++k) {
+        if (&populations_[k].model() != &ModelRegistry::lif()) continue;
+        layout_[k].integrator = static_cast<int>(integrator);
+        populations_[k].setLifIntegrator(integrator);
+    }
+}
+
+LifIntegrator Simulation::lifIntegrator() const { return lifIntegrator_; }
 
 Neuron* Simulation::getNeuron(int idx) const
 {
-    return neurons_.at(idx).get();
+    auto& view = views_.at(idx);
+    if (!view) {
+        const int k = populationOf(idx);
+        auto& pop = const_cast<NeuronPopulation&>(populations_[k]);
+        const std::size_t local = idx - offsets_[k];
+        if (&pop.model() == &ModelRegistry::izhikevich()) {
+            view = std::make_unique<IzhikevichNeuron>(pop, local);
+        } else if (&pop.model() == &ModelRegistry::lif()) {
+            view = std::make_unique<IntegrateAndFireNeuron>(pop, local);
+        } else {
+            view = std::make_unique<PopulationNeuron>(pop, local);
+        }
+    }
+    return view.get();
+}
+
+const NeuronPopulation& Simulation::population(int k) const
+{
+    return populations_.at(k);
+}
+
+const SynapseMatrix& Simulation::connectivity() const
+{
+    return *connectivity_;
 }
 
-const std::vector<std::pair<double, int>>& Simulation::spikeEvents() const
+std::shared_ptr<const SynapseMatrix> Simulation::sharedConnectivity() const
 {
-    return events_;
+    return connectivity_;
+}
+
+void Simulation::setConnectivity(std::shared_ptr<const SynapseMatrix> connectivity)
+{
+    if (connectivity->neuronCount() != neuronCount()) {
+        throw std::invalid_argument("connectivity of " + std::to_string(connectivity->neuronCount()) +
+                                    " neurons for a network of " + std::to_string(neuronCount()));
+    }
+    if (stdp_ && connectivity->weightEncoding() != SynapseMatrix::WeightEncoding::Double) {
+        throw std::logic_error("STDP needs double weights");
+    }
+    if (stdp_ && !connectivity->projections().empty()) {
+        throw std::logic_error("STDP needs stored synapses");
+    }
+    targetEncoding_ = connectivity->targetEncoding();
+    weightEncoding_ = connectivity->weightEncoding();
+    connectivity_ = std::move(connectivity);
+    connectivityChanged();
+}
+
+std::size_t Simulation::synapseCount() const
+{
+    return connectivity_->synapseCount() + connectivity_->proceduralSynapseCount();
+}
+
+void Simulation::setTargetEncoding(SynapseMatrix::TargetEncoding encoding)
+{
+    targetEncoding_ = encoding;
+    if (connectivity_->targetEncoding() != encoding) {
+        ownConnectivity().setTargetEncoding(encoding);
+    }
+}
+
+SynapseMatrix::TargetEncoding Simulation::targetEncoding() const
+{
+    return targetEncoding_;
+}
+
+void Simulation::setWeightEncoding(SynapseMatrix::WeightEncoding encoding)
+{
+    if (stdp_ && encoding != SynapseMatrix::WeightEncoding::Double) {
+        throw std::logic_error("STDP needs double weights");
+    }
+    if (connectivity_->weightEncoding() != encoding) {
+        ownConnectivity().setWeightEncoding(encoding);
+    }
+    weightEncoding_ = encoding;
+}
+
+SynapseMatrix::WeightEncoding Simulation::weightEncoding() const
+{
+    return weightEncoding_;
+}
+
+void Simulation::setProceduralConnectivity(bool enabled)
+{
+    procedural_ = enabled;
+}
+
+bool Simulation::proceduralConnectivity() const
+{
+    return procedural_;
+}
+
+std::vector<std::pair<double, int>> Simulation::spikeEvents() const
+{
+    std::vector<std::pair<double, int>> events;
+    events.reserve(spikes_.size());
+    spikes_.forEach(0, step_, [&](const SpikeEvent& ev) {
+        events.emplace_back(ev.step * dt_, static_cast<int>(ev.neuron));
+    });
+    return events;
+}
+
+std::uint32_t Simulation::readSpikes(std::uint32_t cursor, std::vector<double>& times,
+                                     std::vector<int>& neurons) const
+{
+    spikes_.forEach(cursor, step_, [&](const SpikeEvent& ev) {
+        times.push_back(ev.step * dt_);
+        neurons.push_back(static_cast<int>(ev.neuron));
+    });
+    return step_;
+}
+
+const SpikeStore& Simulation::spikeStore() const
+{
+    return spikes_;
+}
+
+void Simulation::setSpikeRetention(SpikeStore::Retention retention, double window_ms,
+                                   const std::string& spillPath)
+{
+    if (!(window_ms >= 0.0)) {
+        throw std::invalid_argument("spike retention window must be non-negative");
+    }
+    const double steps = std::min(std::ceil(window_ms / dt_),
+                                  double(std::numeric_limits<std::uint32_t>::max()));
+    spikes_.setRetention(retention, static_cast<std::uint32_t>(steps), spillPath);
+}
+
+std::uint32_t Simulation::windowStart(double window_ms) const
+{
+    const auto steps = static_cast<std::uint32_t>(std::lround(std::max(0.0, window_ms) / dt_));
+    return step_ > steps ? step_ - steps : 0;
+}
+
+void Simulation::trackSpikeRate(double window_ms)
+{
+    if (findRateTracker(window_ms)) return;
+
+    const auto steps = static_cast<std::uint32_t>(std::lround(std::max(0.0, window_ms) / dt_));
+    SpikeRateTracker tracker(neuronCount(), steps);
+
+    // Replay the retained part of the window, one step at a time.
+    std::vector<int> fired;
+    std::uint32_t current = windowStart(window_ms);
+    auto flushUntil = [&](std::uint32_t step) {
+        for (; current < step; ++current) {
+            tracker.record(fired);
+            fired.clear();
+        }
+    };
+    spikes_.forEach(windowStart(window_ms), step_, [&](const SpikeEvent& ev) {
+        flushUntil(ev.step);
+        fired.push_back(static_cast<int>(ev.neuron));
+    });
+    flushUntil(step_);
+
+    rateTrackers_.push_back(std::move(tracker));
+}
+
+const SpikeRateTracker* Simulation::findRateTracker(double window_ms) const
+{
+    const auto steps = static_cast<std::uint32_t>(std::lround(std::max(0.0, window_ms) / dt_));
+    for (const auto& tracker : rateTrackers_) {
+        if (tracker.windowSteps() == steps) return &tracker;
+    }
+    return nullptr;
 }
 
 double Simulation::getSpikeRate(int idx, double window_ms) const
 {
-    double startTime = std::max(0.0, currentTime_ - window_ms);
-    int count = std::count_if(events_.begin(), events_.end(),
-        [=](const auto& ev) {
-            return ev.second == idx && ev.first >= startTime && ev.first <= currentTime_;
-        });
+    if (window_ms <= 0.0) return 0.0;
+
+    if (const SpikeRateTracker* tracker = findRateTracker(window_ms)) {
+        return tracker->count(idx) * 1000.0 / window_ms;
+    }
+
+    std::size_t count = 0;
+    spikes_.forEach(windowStart(window_ms), step_, [&](const SpikeEvent& ev) {
+        count += (ev.neuron == static_cast<std::uint32_t>(idx));
+    });
+    return count * 1000.0 / window_ms;
+}
 
-    return (window_ms > 0.0) ? (count * 1000.0 / window_ms) : 0.0;
+std::vector<double> Simulation::getSpikeRates(double window_ms) const
+{
+    std::vector<double> rates(neuronCount(), 0.0);
+    if (window_ms <= 0.0) return rates;
+
+    const double scale = 1000.0 / window_ms;
+    if (const SpikeRateTracker* tracker = findRateTracker(window_ms)) {
+        const auto& counts = tracker->counts();
+        for (std::size_t i = 0; i < rates.size(); ++i) {
+            rates[i] = counts[i] * scale;
+        }
+    } else {
+        spikes_.forEach(windowStart(window_ms), step_, [&](const SpikeEvent& ev) {
+            rates[ev.neuron] += scale;
+        });
+    }
+    return rates;
 }
 
 double Simulation::getSpikeAmplitude(int idx, double /*window_ms*/) const
 {
-    return neurons_.at(idx)->getVoltage();
+    const int k = populationOf(idx);
+    return populations_[k].voltage(idx - offsets_[k]);
 }
 
 void Simulation::setInputCurrent(double current)
@@ -121,6 +741,49 @@ void Simulation::setInputCurrent(double current)
     globalInputCurrent_ = current;
 }
 
+double Simulation::inputCurrent() const
+{
+    return globalInputCurrent_;
+}
+
+void Simulation::requireNeuronIndices(const std::vector<int>& neurons) const
+{
+    for (int idx : neurons) {
+        if (idx < 0 || idx >= neuronCount()) {
+            throw std::invalid_argument("neuron index " + std::to_string(idx) + " out of range [0, " +
+                                        std::to_string(neuronCount()) + ")");
+        }
+    }
+}
+
+std::shared_ptr<StateMonitor> Simulation::addStateMonitor(std::vector<int> neurons,
+                                                          StateMonitor::Variable variable,
+                                                          int interval, std::size_t capacity)
+{
+    requireNeuronIndices(neurons);
+    stateMonitors_.push_back(
+        std::make_shared<StateMonitor>(std::move(neurons), variable, interval, capacity));
+    return stateMonitors_.back();
+}
+
+std::shared_ptr<SpikeMonitor> Simulation::addSpikeMonitor(const std::vector<int>& neurons,
+                                                          std::size_t capacity)
+{
+    requireNeuronIndices(neurons);
+    spikeMonitors_.push_back(std::make_shared<SpikeMonitor>(neurons, neuronCount(), capacity));
+    return spikeMonitors_.back();
+}
+
+void Simulation::removeMonitor(const StateMonitor& monitor)
+{
+    std::erase_if(stateMonitors_, [&](const auto& m) { return m.get() == &monitor; });
+}
+
+void Simulation::removeMonitor(const SpikeMonitor& monitor)
+{
+    std::erase_if(spikeMonitors_, [&](const auto& m) { return m.get() == &monitor; });
+}
+
 void Simulation::setSelectedNeuron(int index)
 {
     selectedNeuronIndex_ = index;
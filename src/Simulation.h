@@ -8,18 +8,59 @@
 #define SIMULATION_H
 
 #include "Neuron.h"
+#include "NeuronPopulation.h"
 #include "Synapse.h"
+#include "SpikeMonitor.h"
+#include "SpikeRateTracker.h"
+#include "SpikeStore.h"
+#include "StateMonitor.h"
+#include "Stdp.h"
+#include "SynapseMatrix.h"
+#include "ThreadPool.h"
 #include <vector>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
+/**
+ * @struct RunLimits
+ * @brief Optional stop conditions for Simulation::run(); zero means unlimited.
+ */
+struct RunLimits
+{
+    std::uint64_t maxSpikes = 0;   ///< Stop once this many spikes were recorded during the run
+    double maxWallSeconds = 0.0;   ///< Stop once this much wall-clock time has elapsed
+};
+
+/**
+ * @struct PopulationConfig
+ * @brief One named population of a Simulation (see Simulation::setPopulations()).
+ */
+struct PopulationConfig
+{
+    std::string name;                        ///< Unique name, used to address projections
+    const ModelDescriptor* model = nullptr;  ///< Registered neuron model (nullptr: LIF)
+    int size = 0;                            ///< Number of neurons
+    std::vector<double> params;              ///< Model parameters; missing trailing values default
+    int integrator = 0;                      ///< Index of the model's integrator
+    int substeps = 1;                        ///< Integration substeps per update
+};
+
 /**
  * @class Simulation
  * @brief Manages a network of spiking neurons and synaptic interactions.
  *
- * Encapsulates a 2D grid of neurons, a list of synaptic connections,
- * and spike-event recording. Provides the main step-based update loop and
+ * Encapsulates a 2D grid of neurons, synaptic connections in CSR layout, and
+ * spike-event recording. Provides the main step-based update loop and
  * access to voltages and spike data for visualization.
+ *
+ * The neurons form one or more named populations, each a structure-of-arrays
+ * NeuronPopulation of a single model updated by that model's kernel.
+ * Populations occupy consecutive ranges of the neuron indices, which are the
+ * indices used throughout (connectivity, spikes, monitors). By default the
+ * whole grid is one LIF population called "neurons".
  */
 class Simulation
 {
@@ -29,29 +70,172 @@ public:
      * @param nx Grid width (columns).
      * @param ny Grid height (rows).
      * @param dt Integration time step in milliseconds.
+     * @param threads Worker threads used by step(); 0 uses all hardware threads.
+     * @param precision Scalar type of the neuron state (float halves memory
+     *        traffic and doubles the SIMD width).
      */
-    Simulation(int nx, int ny, double dt = 0.1);
+    Simulation(int nx, int ny, double dt = 0.1, int threads = 1,
+               NeuronPopulation::Precision precision = NeuronPopulation::Precision::Double);
 
-    /** @brief Initialize or reset all neurons. */
+    /**
+     * @brief Initialize or reset all neurons, keeping the population layout.
+     * @throws std::logic_error if the population storage is pinned (see pinStorage()).
+     */
     void initializeNeurons();
 
+    /**
+     * @brief Replace the neurons by consecutive named populations.
+     *
+     * Population k takes the neuron indices following those of population
+     * k - 1, filling the grid row by row. Resets the network like
+     * initializeNeurons(), dropping all synapses.
+     *
+     * @param populations Layout; the sizes must add up to nx × ny.
+     * @throws std::invalid_argument if the sizes do not add up or a name is
+     *         empty or used twice.
+     * @throws std::logic_error if the population storage is pinned (see pinStorage()).
+     */
+    void setPopulations(std::vector<PopulationConfig> populations);
+
+    /** @return Layout of the populations, in index order. */
+    const std::vector<PopulationConfig>& populations() const;
+
+    /** @return Number of populations. */
+    int populationCount() const;
+
+    /**
+     * @return Index of the population called @p name.
+     * @throws std::invalid_argument if there is no such population.
+     */
+    int populationIndex(const std::string& name) const;
+
+    /** @return Neuron indices [begin, end) of population @p k. */
+    std::pair<int, int> populationRange(int k) const;
+
+    /** @return Index of the population holding neuron @p idx. */
+    int populationOf(int idx) const;
+
+    /**
+     * @brief Keep the population storage in place while the returned token is held.
+     *
+     * For views of the storage that outlive a call, such as the zero-copy
+     * NumPy arrays of the Python bindings: while any copy of a token exists,
+     * initializeNeurons() and setPopulations(), which reallocate the storage,
+     * throw instead. Stepping the simulation is unaffected.
+     *
+     * @return Token pinning the storage until every copy is destroyed.
+     */
+    std::shared_ptr<const void> pinStorage() const;
+
     /**
      * @brief Create random connections between neurons.
+     *
+     * Each ordered pair of distinct neurons is connected independently with
+     * probability @p p. Rows are generated in parallel by jumping between
+     * targets with geometric skips, O(N + synapses), from random streams
+     * derived from (seed, source, block of targets) (see RandomProjection),
+     * so a given seed yields the same graph at any thread count.
+     *
+     * With setProceduralConnectivity(true) only the projection's parameters
+     * are kept, and its rows are regenerated whenever a neuron spikes.
+     *
      * @param p Probability of a connection between two neurons.
      * @param weight Synaptic weight in nanoamperes (nA).
+     * @param delay Transmission delay in ms (rounded to steps, at least one step).
+     * @param seed Generator seed; a random seed is drawn when empty.
+     * @param source Population of the presynaptic neurons; empty for all neurons.
+     * @param target Population of the postsynaptic neurons; empty for all neurons.
+     * @throws std::logic_error if the connections would be procedural while STDP is enabled.
      */
-    void connectRandom(double p, double weight);
+    void connectRandom(double p, double weight, double delay = 0.0,
+                       std::optional<std::uint64_t> seed = std::nullopt,
+                       const std::string& source = {}, const std::string& target = {});
 
     /**
      * @brief Create local connections within a radius.
+     *
+     * The in-radius offsets are computed once as a stencil and applied to
+     * every neuron, O(N × stencil size), with rows generated in parallel
+     * directly into CSR storage.
+     *
      * @param radius Maximum distance (in grid units).
      * @param weight Synaptic weight (nA).
+     * @param delay Base transmission delay in ms.
+     * @param delayPerUnit Additional delay in ms per grid unit of distance.
+     * @param wrap Wrap around the grid edges (torus) instead of clipping.
+     * @param source Population of the presynaptic neurons; empty for all neurons.
+     * @param target Population of the postsynaptic neurons; empty for all neurons.
+     * @throws std::invalid_argument if radius is negative or NaN.
+     */
+    void connectByProximity(double radius, double weight,
+                            double delay = 0.0, double delayPerUnit = 0.0,
+                            bool wrap = false,
+                            const std::string& source = {}, const std::string& target = {});
+
+    /**
+     * @brief Make synaptic weights plastic under spike-timing-dependent plasticity.
+     *
+     * After each step's delivery, the weights of the synapses of spiking
+     * neurons are updated event by event (see Stdp), so the cost grows with
+     * the spike count, not the synapse count. Synapses added later are
+     * plastic too. Traces restart at zero, also on initializeNeurons().
+     *
+     * @param rule STDP parameters.
+     * @param source Population whose outgoing synapses are plastic; empty for all.
+     * @throws std::invalid_argument unless dt and the rule's time constants are positive.
+     * @throws std::logic_error if the weights are quantized (see setWeightEncoding())
+     *         or the connectivity has procedural projections.
      */
-    void connectByProximity(double radius, double weight);
+    void enableStdp(const StdpRule& rule, const std::string& source = {});
 
-    /** @brief Advance the network by one simulation step (dt). */
+    /** @brief Freeze the weights again. */
+    void disableStdp();
+
+    /** @return Plasticity state, or nullptr when STDP is disabled. */
+    const Stdp* stdp() const;
+
+    /**
+     * @brief Advance the network by one simulation step (dt).
+     *
+     * Updates all neurons, then delivers synaptic current along the outgoing
+     * rows of the neurons that fired; the current is integrated next step.
+     * With STDP enabled, the weights of their synapses are updated next.
+     * With several threads, both phases are partitioned across the worker
+     * pool, separated by a barrier. Updates are split in proportion to the
+     * cost of each population's kernel (NeuronPopulation::cost()), delivery
+     * by target neuron, so results are bit-identical for any thread count.
+     */
     void step();
 
+    /**
+     * @brief Advance the network by several steps in one call.
+     *
+     * Stops early when one of the @p limits is reached; a limit is checked
+     * after every step, so the step that crosses it completes.
+     *
+     * @param steps Number of steps to simulate.
+     * @param limits Optional spike-count and wall-clock budgets.
+     * @return Number of steps actually simulated.
+     */
+    int run(int steps, const RunLimits& limits = {});
+
+    /**
+     * @brief Advance the network by a span of simulated time.
+     * @param ms Simulated time in milliseconds (rounded to whole steps).
+     * @param limits Optional spike-count and wall-clock budgets.
+     * @return Number of steps actually simulated.
+     */
+    int runFor(double ms, const RunLimits& limits = {});
+
+    /**
+     * @brief Resize the worker pool used by step().
+     * @param threads Number of threads; 0 uses all hardware threads.
+     */
+    void setThreadCount(int threads);
+
+    /** @return Number of threads used by step(). */
+    int threadCount() const;
+
     /** @return Total number of neurons (nx × ny). */
     int neuronCount() const;
 
@@ -63,28 +247,202 @@ public:
 
     /**
      * @brief Get a pointer to a neuron by index.
+     *
+     * Returns a view onto the population storage, created on first access and
+     * owned by the simulation. Views are invalidated by initializeNeurons().
+     * Built-in models get their neuron class; registered models get a
+     * PopulationNeuron.
+     *
      * @param idx Linear index of the neuron.
      * @return Pointer to Neuron.
      */
     Neuron* getNeuron(int idx) const;
 
+    /**
+     * @return Population @p k, holding the neurons of populationRange(k);
+     *         population 0 holds all neurons unless setPopulations() was used.
+     */
+    const NeuronPopulation& population(int k = 0) const;
+
+    /** @return Outgoing synapses of all neurons in CSR layout. */
+    const SynapseMatrix& connectivity() const;
+
+    /**
+     * @brief Share the connectivity with other simulations.
+     *
+     * Matrices are immutable while shared: the next connect call of any
+     * holder works on a private copy.
+     *
+     * @return Shared handle to the outgoing synapses.
+     */
+    std::shared_ptr<const SynapseMatrix> sharedConnectivity() const;
+
+    /**
+     * @brief Replace the connectivity with one shared by another simulation.
+     *
+     * The simulation adopts the matrix's target and weight encodings.
+     *
+     * @param connectivity Matrix with neuronCount() rows.
+     * @throws std::invalid_argument if the matrix has a different number of neurons.
+     * @throws std::logic_error if STDP is enabled and the weights are quantized.
+     */
+    void setConnectivity(std::shared_ptr<const SynapseMatrix> connectivity);
+
+    /** @return Total number of synapses, stored and procedural. */
+    std::size_t synapseCount() const;
+
+    /**
+     * @brief Select how the connectivity stores target indices.
+     *
+     * Converts the existing synapses and applies to later connect calls and
+     * initializeNeurons(); spike delivery and plasticity are unaffected.
+     * Use connectivity().bytesPerSynapse() to compare the footprints.
+     *
+     * @param encoding Target encoding.
+     */
+    void setTargetEncoding(SynapseMatrix::TargetEncoding encoding);
+
+    /** @return Target encoding of the connectivity. */
+    SynapseMatrix::TargetEncoding targetEncoding() const;
+
+    /**
+     * @brief Select how the connectivity stores synaptic weights.
+     *
+     * Converts the existing synapses and applies to later connect calls and
+     * initializeNeurons(). Quantized weights are decoded during delivery;
+     * connectivity().weightError() reports their error against double weights.
+     *
+     * @param encoding Weight encoding.
+     * @throws std::logic_error if STDP is enabled and @p encoding is not Double.
+     * @throws std::invalid_argument if Shared is requested for more than 256
+     *         distinct weights.
+     */
+    void setWeightEncoding(SynapseMatrix::WeightEncoding encoding);
+
+    /** @return Weight encoding of the connectivity. */
+    SynapseMatrix::WeightEncoding weightEncoding() const;
+
+    /**
+     * @brief Make later connectRandom() calls procedural instead of stored.
+     *
+     * A procedural projection keeps only its seed, probability, weight,
+     * delay and population ranges, and regenerates a neuron's targets from
+     * (seed, neuron) whenever it spikes. Its spikes cost generator arithmetic
+     * instead of memory traffic, and its synapses take no memory, so networks
+     * much larger than RAM fit. With the same seed the synapses are the same
+     * as those of a stored build, and so are the dynamics, unless stored
+     * synapses added before a procedural projection share a source, target
+     * and delay with it. Then only the summation order differs. Procedural
+     * synapses are not plastic.
+     *
+     * @param enabled Whether connectRandom() creates procedural projections.
+     */
+    void setProceduralConnectivity(bool enabled);
+
+    /** @return Whether connectRandom() creates procedural projections. */
+    bool proceduralConnectivity() const;
+
     /** @return Current simulation time in milliseconds. */
     double currentTime() const;
 
+    /** @return Number of steps simulated so far. */
+    std::uint32_t currentStep() const;
+
+    /** @return Integration time step in milliseconds. */
+    double dt() const;
+
+    /** @return Scalar type of the neuron state. */
+    NeuronPopulation::Precision precision() const;
+
+    /**
+     * @brief Select how the LIF neurons are integrated.
+     *
+     * LifIntegrator::Exact applies the closed-form solution for input held
+     * constant over a step, so dt of 0.5–1 ms keeps the spike statistics of
+     * small-step Euler. Applies to every LIF population and persists across
+     * initializeNeurons().
+     *
+     * @param integrator Integration scheme.
+     */
+    void setLifIntegrator(LifIntegrator integrator);
+
+    /** @return Integration scheme last selected for the LIF neurons. */
+    LifIntegrator lifIntegrator() const;
+
     /**
-     * @brief Get spike history.
+     * @brief Get the retained spike history.
+     *
+     * Materializes a copy of every spike held in memory; prefer spikeStore()
+     * window queries for anything called repeatedly.
+     *
      * @return Vector of (time, neuron index) pairs.
      */
-    const std::vector<std::pair<double, int>>& spikeEvents() const;
+    std::vector<std::pair<double, int>> spikeEvents() const;
+
+    /**
+     * @brief Append the spikes recorded since a cursor, in columnar layout.
+     *
+     * Poll with the returned cursor to receive each spike once, at O(new
+     * spikes) per call. Spikes already evicted by the retention policy are
+     * skipped.
+     *
+     * @param cursor Step returned by the previous call (0 for the first).
+     * @param times Receives the spike times in ms.
+     * @param neurons Receives the neuron indices.
+     * @return Cursor for the next call (the current step).
+     */
+    std::uint32_t readSpikes(std::uint32_t cursor, std::vector<double>& times,
+                             std::vector<int>& neurons) const;
+
+    /** @return Time-indexed spike storage. */
+    const SpikeStore& spikeStore() const;
+
+    /**
+     * @brief Configure how long spikes are kept in memory.
+     * @param retention Policy for spikes older than the window.
+     * @param window_ms Time window kept in memory (ms).
+     * @param spillPath File receiving evicted spikes for SpillToDisk.
+     * @throws std::invalid_argument if window_ms is negative or NaN.
+     */
+    void setSpikeRetention(SpikeStore::Retention retention, double window_ms = 0.0,
+                           const std::string& spillPath = {});
+
+    /**
+     * @brief Convert a time window to the step range ending at the current step.
+     * @param window_ms Window length in milliseconds.
+     * @return First step inside the window.
+     */
+    std::uint32_t windowStart(double window_ms) const;
+
+    /**
+     * @brief Maintain per-neuron spike counts for a window incrementally in step().
+     *
+     * Rate queries for a tracked window cost O(1) per neuron. Tracking starts
+     * from the spikes still held by the spike store.
+     *
+     * @param window_ms Time window in milliseconds.
+     */
+    void trackSpikeRate(double window_ms);
 
     /**
      * @brief Calculate spike rate for a neuron over a time window.
+     *
+     * O(1) for windows registered with trackSpikeRate(), otherwise a window
+     * query on the spike store.
+     *
      * @param idx Neuron index.
      * @param window_ms Time window in milliseconds.
      * @return Spike rate in Hz.
      */
     double getSpikeRate(int idx, double window_ms) const;
 
+    /**
+     * @brief Calculate the spike rates of all neurons in one pass.
+     * @param window_ms Time window in milliseconds.
+     * @return Spike rate in Hz of every neuron.
+     */
+    std::vector<double> getSpikeRates(double window_ms) const;
+
     /**
      * @brief Estimate spike amplitude (proxy).
      * @param idx Neuron index.
@@ -93,12 +451,49 @@ public:
      */
     double getSpikeAmplitude(int idx, double window_ms) const;
 
+    /**
+     * @brief Attach a monitor recording a state variable inside step().
+     *
+     * The monitor is owned by the simulation and samples the state after
+     * every update whose step index is a multiple of @p interval.
+     *
+     * @param neurons Indices of the monitored neurons.
+     * @param variable Recorded state variable.
+     * @param interval Sampling interval in steps.
+     * @param capacity Number of samples kept (older ones are overwritten).
+     * @return The new monitor, shared with the simulation; it keeps its
+     *         samples after removeMonitor() for as long as it is held.
+     * @throws std::invalid_argument if a neuron index is out of range.
+     */
+    std::shared_ptr<StateMonitor> addStateMonitor(std::vector<int> neurons,
+                                                  StateMonitor::Variable variable,
+                                                  int interval, std::size_t capacity);
+
+    /**
+     * @brief Attach a monitor recording spikes inside step().
+     * @param neurons Indices of the monitored neurons; empty monitors all.
+     * @param capacity Number of spike events kept (older ones are overwritten).
+     * @return The new monitor, shared with the simulation like addStateMonitor()'s.
+     * @throws std::invalid_argument if a neuron index is out of range.
+     */
+    std::shared_ptr<SpikeMonitor> addSpikeMonitor(const std::vector<int>& neurons,
+                                                  std::size_t capacity);
+
+    /** @brief Detach a state monitor; it stops recording and is destroyed once no longer held. */
+    void removeMonitor(const StateMonitor& monitor);
+
+    /** @brief Detach a spike monitor; it stops recording and is destroyed once no longer held. */
+    void removeMonitor(const SpikeMonitor& monitor);
+
     /**
      * @brief Set uniform external input current to all neurons.
      * @param current Input current in nA.
      */
     void setInputCurrent(double current);
 
+    /** @return Uniform external input current (nA). */
+    double inputCurrent() const;
+
     /**
      * @brief Select a neuron for external tracking (e.g., in trace views).
      * @param index Neuron index.
@@ -108,15 +503,73 @@ public:
 private:
     int nx_, ny_;
     double dt_;
-    double currentTime_;
+    NeuronPopulation::Precision precision_;
+    LifIntegrator lifIntegrator_ = LifIntegrator::Euler;
+    std::uint32_t step_;
+
+    std::vector<PopulationConfig> layout_;     ///< Populations in index order
+    std::vector<NeuronPopulation> populations_;
+    std::vector<int> offsets_;                 ///< First neuron of each population, then N
+    std::shared_ptr<const SynapseMatrix> connectivity_;  ///< Copied on write when shared
+    SynapseMatrix::TargetEncoding targetEncoding_ = SynapseMatrix::TargetEncoding::Plain;
+    SynapseMatrix::WeightEncoding weightEncoding_ = SynapseMatrix::WeightEncoding::Double;
+    bool procedural_ = false;                  ///< connectRandom() creates procedural projections
+    std::unique_ptr<Stdp> stdp_;               ///< Plasticity state, null when disabled
+    std::string stdpSource_;                   ///< Population with plastic synapses (empty: all)
+    SpikeStore spikes_;
+    std::vector<SpikeRateTracker> rateTrackers_;  ///< Incremental rate windows
+    std::vector<std::shared_ptr<StateMonitor>> stateMonitors_;
+    std::vector<std::shared_ptr<SpikeMonitor>> spikeMonitors_;
+    std::vector<int> fired_;  ///< Neurons that spiked in the last step
 
-    std::vector<std::unique_ptr<Neuron>> neurons_;
-    std::vector<Synapse> synapses_;
-    std::vector<std::pair<double, int>> events_;
+    std::unique_ptr<ThreadPool> pool_;             ///< Persistent step workers
+    std::vector<std::vector<int>> workerFired_;    ///< Per-worker spike lists
+
+    mutable std::vector<std::unique_ptr<Neuron>> views_;  ///< Lazily created getNeuron() views
+    mutable std::weak_ptr<const void> storagePin_;        ///< Token of pinStorage(), if held
 
     double globalInputCurrent_ = 0.0;
     int selectedNeuronIndex_ = -1;
 
+    /** @brief Throw std::logic_error if the population storage is pinned. */
+    void requireUnpinnedStorage() const;
+
+    /** @brief Throw std::invalid_argument unless every index is a neuron of the network. */
+    void requireNeuronIndices(const std::vector<int>& neurons) const;
+
+    /** @brief Tracker for a window of @p window_ms, or nullptr if untracked. */
+    const SpikeRateTracker* findRateTracker(double window_ms) const;
+
+    /** @brief Convert a delay in ms to whole steps (at least one). */
+    int delaySteps(double delay) const;
+
+    /** @brief Add synapses to the CSR matrix and grow the input ring if needed. */
+    void addSynapses(const std::vector<Synapse>& synapses);
+
+    /** @brief Connectivity safe to modify, copied first if shared. */
+    SynapseMatrix& ownConnectivity();
+
+    /** @brief Add row-ordered synapses to the CSR matrix and grow the input ring if needed. */
+    void addSynapses(SynapseRows rows);
+
+    /** @brief Parallel version of step() for pools with more than one thread. */
+    void stepParallel();
+
+    /** @brief Update neurons [begin, end), appending the ones that fired. */
+    void updateRange(int begin, int end, std::vector<int>& fired);
+
+    /** @brief Deliver the spikes of the step to targets in [begin, end). */
+    void deliverRange(int begin, int end);
+
+    /** @brief Give every population at least @p slots synaptic input slots, keeping them in phase. */
+    void reserveDelaySlots(std::size_t slots);
+
+    /** @brief Adapt to changed connectivity: input slots and the STDP index. */
+    void connectivityChanged();
+
+    /** @brief Neuron range [begin, end) of a population name; all neurons if empty. */
+    std::pair<int, int> rangeOf(const std::string& name) const;
+
     /** @brief Convert 2D grid coordinates to a flat array index. */
     int index(int x, int y) const { return y * nx_ + x; }
 };
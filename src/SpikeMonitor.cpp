@@ -0,0 +1,38 @@
+/**
+ * @file SpikeMonitor.cpp
+ * @brief Implements spike recording into the preallocated ring buffer.
+ * @author Dario Romandini
+ */
+
+#include "SpikeMonitor.h"
+#include <algorithm>
+
+SpikeMonitor::SpikeMonitor(const std::vector<int>& neurons, std::size_t neuronCount,
+                           std::size_t capacity)
+    : events_(capacity)
+{
+    if (!neurons.empty()) {
+        watched_.assign(neuronCount, 0);
+        for (int idx : neurons) watched_[idx] = 1;
+    }
+}
+
+void SpikeMonitor::record(std::uint32_t step, const std::vector<int>& fired)
+{
+    if (events_.empty()) return;
+
+    for (int idx : fired) {
+        if (!watched_.empty() && !watched_[idx]) continue;
+        events_[next_] = SpikeEvent{step, static_cast<std::uint32_t>(idx)};
+        next_ = (next_ + 1) % events_.size();
+        size_ = std::min(size_ + 1, events_.size());
+        ++total_;
+    }
+}
+
+void SpikeMonitor::clear()
+{
+    next_ = 0;
+    size_ = 0;
+    total_ = 0;
+}
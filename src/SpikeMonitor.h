@@ -0,0 +1,67 @@
+/**
+ * @file SpikeMonitor.h
+ * @brief Records the spikes of selected neurons inside the step loop.
+ * @author Dario Romandini
+ */
+
+#ifndef SPIKE_MONITOR_H
+#define SPIKE_MONITOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SpikeStore.h"
+
+/**
+ * @class SpikeMonitor
+ * @brief Collects the spikes of a neuron subset into a preallocated ring buffer.
+ *
+ * Independent of the simulation's spike retention policy. The buffer holds
+ * capacity() events and is allocated once; when it is full the oldest event
+ * is overwritten.
+ */
+class SpikeMonitor
+{
+public:
+    /**
+     * @brief Construct a monitor with a preallocated buffer.
+     * @param neurons Indices of the monitored neurons; empty monitors all.
+     * @param neuronCount Number of neurons in the network.
+     * @param capacity Number of spike events kept.
+     */
+    SpikeMonitor(const std::vector<int>& neurons, std::size_t neuronCount, std::size_t capacity);
+
+    /**
+     * @brief Append the monitored spikes of one step.
+     * @param step Step index.
+     * @param fired Indices of the neurons that fired.
+     */
+    void record(std::uint32_t step, const std::vector<int>& fired);
+
+    /** @brief Drop all events, keeping the buffer. */
+    void clear();
+
+    /** @return Maximum number of events kept. */
+    std::size_t capacity() const { return events_.size(); }
+
+    /** @return Number of events held, at most capacity(). */
+    std::size_t size() const { return size_; }
+
+    /** @return Number of events recorded, including overwritten ones. */
+    std::uint64_t totalRecorded() const { return total_; }
+
+    /** @return Held event @p k, 0 being the oldest. */
+    const SpikeEvent& event(std::size_t k) const
+    {
+        return events_[(next_ + events_.size() - size_ + k) % events_.size()];
+    }
+
+private:
+    std::vector<std::uint8_t> watched_;  ///< Membership flag per neuron (empty = all)
+    std::vector<SpikeEvent> events_;     ///< Ring of recorded events
+    std::size_t next_ = 0;               ///< Ring position written next
+    std::size_t size_ = 0;               ///< Events held
+    std::uint64_t total_ = 0;            ///< Events recorded so far
+};
+
+#endif // SPIKE_MONITOR_H
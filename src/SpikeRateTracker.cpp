@@ -0,0 +1,30 @@
+/**
+ * @file SpikeRateTracker.cpp
+ * @brief Implements the sliding-window spike counter.
+ * @author Dario Romandini
+ */
+
+#include "SpikeRateTracker.h"
+
+SpikeRateTracker::SpikeRateTracker(std::size_t neuronCount, std::uint32_t windowSteps)
+    : windowSteps_(windowSteps), counts_(neuronCount, 0)
+{}
+
+void SpikeRateTracker::record(const std::vector<int>& fired)
+{
+    if (windowSteps_ == 0) return;
+
+    for (int idx : fired) {
+        ++counts_[idx];
+        spikes_.push_back(idx);
+    }
+    perStep_.push_back(static_cast<std::uint32_t>(fired.size()));
+
+    if (perStep_.size() > windowSteps_) {
+        for (std::uint32_t n = perStep_.front(); n > 0; --n) {
+            --counts_[spikes_.front()];
+            spikes_.pop_front();
+        }
+        perStep_.pop_front();
+    }
+}
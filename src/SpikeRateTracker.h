@@ -0,0 +1,56 @@
+/**
+ * @file SpikeRateTracker.h
+ * @brief Incremental per-neuron spike counts over a sliding time window.
+ * @author Dario Romandini
+ */
+
+#ifndef SPIKE_RATE_TRACKER_H
+#define SPIKE_RATE_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @class SpikeRateTracker
+ * @brief Sliding-window spike counter for every neuron.
+ *
+ * Fed once per step with the neurons that fired, it increments their counts
+ * and decrements the counts of the spikes that just left the window. Each
+ * update costs O(spikes), and reading one rate or all rates costs O(1) per
+ * neuron, independent of the length of the spike history.
+ */
+class SpikeRateTracker
+{
+public:
+    /**
+     * @brief Construct a tracker with all counts at zero.
+     * @param neuronCount Number of neurons.
+     * @param windowSteps Window length in steps.
+     */
+    SpikeRateTracker(std::size_t neuronCount, std::uint32_t windowSteps);
+
+    /**
+     * @brief Advance the window by one step.
+     * @param fired Indices of the neurons that fired in this step.
+     */
+    void record(const std::vector<int>& fired);
+
+    /** @return Number of spikes of neuron @p idx in the window. */
+    std::uint32_t count(std::size_t idx) const { return counts_[idx]; }
+
+    /** @return Spike counts of all neurons in the window. */
+    const std::vector<std::uint32_t>& counts() const { return counts_; }
+
+    /** @return Window length in steps. */
+    std::uint32_t windowSteps() const { return windowSteps_; }
+
+private:
+    std::uint32_t windowSteps_;
+    std::vector<std::uint32_t> counts_;   ///< Spikes per neuron in the window
+    std::deque<int> spikes_;              ///< Spiking neurons, oldest step first
+    std::deque<std::uint32_t> perStep_;   ///< Number of spikes of each step in the window
+};
+
+#endif // SPIKE_RATE_TRACKER_H
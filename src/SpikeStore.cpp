@@ -0,0 +1,91 @@
+/**
+ * @file SpikeStore.cpp
+ * @brief Implements chunked spike recording, window queries and retention.
+ * @author Dario Romandini
+ */
+
+#include "SpikeStore.h"
+#include <fstream>
+#include <stdexcept>
+
+SpikeStore::SpikeStore(std::uint32_t stepsPerChunk)
+    : stepsPerChunk_(std::max<std::uint32_t>(stepsPerChunk, 1))
+{}
+
+void SpikeStore::setRetention(Retention retention, std::uint32_t windowSteps,
+                              const std::string& spillPath)
+{
+    if (retention == Retention::SpillToDisk && spillPath.empty()) {
+        throw std::invalid_argument("SpikeStore: spilling requires a file path");
+    }
+    retention_ = retention;
+    windowSteps_ = windowSteps;
+    spillPath_ = spillPath;
+}
+
+void SpikeStore::record(std::uint32_t step, const std::vector<int>& fired)
+{
+    if (!fired.empty()) {
+        const std::uint32_t bucket = step / stepsPerChunk_;
+        if (chunks_.empty() || chunks_.back().bucket != bucket) {
+            chunks_.push_back(Chunk{bucket, {}});
+        }
+        auto& events = chunks_.back().events;
+        for (int neuron : fired) {
+            events.push_back(SpikeEvent{step, static_cast<std::uint32_t>(neuron)});
+        }
+        size_ += fired.size();
+        total_ += fired.size();
+    }
+
+    if (retention_ != Retention::KeepAll) {
+        evict(step);
+    }
+}
+
+void SpikeStore::evict(std::uint32_t step)
+{
+    if (step < windowSteps_) return;
+    const std::uint32_t oldest = step - windowSteps_;
+
+    std::ofstream spill;
+    while (!chunks_.empty() && (std::uint64_t(chunks_.front().bucket) + 1) * stepsPerChunk_ <= oldest) {
+        auto& chunk = chunks_.front();
+        if (retention_ == Retention::SpillToDisk) {
+            if (!spill.is_open()) {
+                spill.open(spillPath_, std::ios::binary | std::ios::app);
+                if (!spill) {
+                    throw std::runtime_error("SpikeStore: cannot open spill file " + spillPath_);
+                }
+            }
+            spill.write(reinterpret_cast<const char*>(chunk.events.data()),
+                        static_cast<std::streamsize>(chunk.events.size() * sizeof(SpikeEvent)));
+            if (!spill.flush()) {
+                throw std::runtime_error("SpikeStore: cannot write spill file " + spillPath_);
+            }
+        }
+        size_ -= chunk.events.size();
+        chunks_.pop_front();
+    }
+}
+
+std::vector<SpikeEvent> SpikeStore::range(std::uint32_t firstStep, std::uint32_t lastStep) const
+{
+    std::vector<SpikeEvent> events;
+    forEach(firstStep, lastStep, [&](const SpikeEvent& e) { events.push_back(e); });
+    return events;
+}
+
+std::size_t SpikeStore::count(std::uint32_t firstStep, std::uint32_t lastStep) const
+{
+    std::size_t n = 0;
+    forEach(firstStep, lastStep, [&](const SpikeEvent&) { ++n; });
+    return n;
+}
+
+void SpikeStore::clear()
+{
+    chunks_.clear();
+    size_ = 0;
+    total_ = 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file SpikeStore.h
+ * @brief Chunked, time-indexed spike storage with a configurable retention policy.
+ * @author Dario Romandini
+ */
+
+#ifndef SPIKE_STORE_H
+#define SPIKE_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @struct SpikeEvent
+ * @brief A compact spike record: simulation step index and neuron id (8 bytes).
+ */
+struct SpikeEvent
+{
+    std::uint32_t step;    ///< Step index at which the neuron fired
+    std::uint32_t neuron;  ///< Index of the neuron
+
+    bool operator==(const SpikeEvent&) const = default;
+};
+
+static_assert(sizeof(SpikeEvent) == 8, "SpikeEvent must stay 8 bytes");
+
+/**
+ * @class SpikeStore
+ * @brief Spike history bucketed into chunks of consecutive steps.
+ *
+ * Spikes are appended in step order. Each chunk covers a fixed bucket of
+ * stepsPerChunk() steps, so a window query finds its first chunk by binary
+ * search and touches only the chunks overlapping the window, O(log n + k).
+ *
+ * The retention policy decides what happens to old chunks: keep everything,
+ * drop chunks that fall entirely outside the last N steps, or append such
+ * chunks to a binary file (raw SpikeEvent records) before dropping them.
+ */
+class SpikeStore
+{
+public:
+    /** @brief What to do with spikes older than the retention window. */
+    enum class Retention { KeepAll, KeepWindow, SpillToDisk };
+
+    /**
+     * @brief Construct an empty store that keeps everything.
+     * @param stepsPerChunk Number of steps covered by each chunk.
+     */
+    explicit SpikeStore(std::uint32_t stepsPerChunk = 1024);
+
+    /**
+     * @brief Configure the retention policy.
+     * @param retention Policy for old spikes.
+     * @param windowSteps Steps to keep in memory (KeepWindow / SpillToDisk).
+     * @param spillPath File receiving evicted spikes (SpillToDisk only).
+     */
+    void setRetention(Retention retention, std::uint32_t windowSteps = 0,
+                      const std::string& spillPath = {});
+
+    /** @return Current retention policy. */
+    Retention retention() const { return retention_; }
+
+    /**
+     * @brief Append the spikes of one step and apply the retention policy.
+     * @param step Step index; must not decrease between calls.
+     * @param fired Indices of the neurons that fired.
+     * @throws std::runtime_error if evicted spikes cannot be spilled; they stay in memory.
+     */
+    void record(std::uint32_t step, const std::vector<int>& fired);
+
+    /**
+     * @brief Visit retained spikes with step in [firstStep, lastStep) in order.
+     * @param firstStep First step of the window.
+     * @param lastStep One past the last step of the window.
+     * @param fn Callable taking a const SpikeEvent&.
+     */
+    template <typename Fn>
+    void forEach(std::uint32_t firstStep, std::uint32_t lastStep, Fn&& fn) const
+    {
+        auto chunk = std::lower_bound(chunks_.begin(), chunks_.end(), firstStep / stepsPerChunk_,
+            [](const Chunk& c, std::uint32_t bucket) { return c.bucket < bucket; });
+        for (; chunk != chunks_.end() && std::uint64_t(chunk->bucket) * stepsPerChunk_ < lastStep; ++chunk) {
+            auto it = std::lower_bound(chunk->events.begin(), chunk->events.end(), firstStep,
+                [](const SpikeEvent& e, std::uint32_t step) { return e.step < step; });
+            for (; it != chunk->events.end() && it->step < lastStep; ++it) {
+                fn(*it);
+            }
+        }
+    }
+
+    /** @return Retained spikes with step in [firstStep, lastStep). */
+    std::vector<SpikeEvent> range(std::uint32_t firstStep, std::uint32_t lastStep) const;
+
+    /** @return Number of retained spikes with step in [firstStep, lastStep). */
+    std::size_t count(std::uint32_t firstStep, std::uint32_t lastStep) const;
+
+    /** @return Number of spikes currently held in memory. */
+    std::size_t size() const { return size_; }
+
+    /** @return Whether no spikes are held in memory. */
+    bool empty() const { return size_ == 0; }
+
+    /** @return Number of spikes ever recorded, including evicted ones. */
+    std::uint64_t totalRecorded() const { return total_; }
+
+    /** @return Number of steps covered by one chunk. */
+    std::uint32_t stepsPerChunk() const { return stepsPerChunk_; }
+
+    /** @brief Drop all spikes (the spill file is left untouched). */
+    void clear();
+
+private:
+    struct Chunk
+    {
+        std::uint32_t bucket;             ///< step / stepsPerChunk of all events
+        std::vector<SpikeEvent> events;   ///< Spikes sorted by step
+    };
+
+    void evict(std::uint32_t step);
+
+    std::uint32_t stepsPerChunk_;
+    std::deque<Chunk> chunks_;
+    std::size_t size_ = 0;
+    std::uint64_t total_ = 0;
+
+    Retention retention_ = Retention::KeepAll;
+    std::uint32_t windowSteps_ = 0;
+    std::string spillPath_;
+};
+
+#endif // SPIKE_STORE_H
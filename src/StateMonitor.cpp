@@ -0,0 +1,78 @@
+/**
+ * @file StateMonitor.cpp
+ * @brief Implements state sampling into the preallocated ring buffer.
+ * @author Dario Romandini
+ */
+
+#include "StateMonitor.h"
+#include <algorithm>
+#include <utility>
+
+StateMonitor::StateMonitor(std::vector<int> neurons, Variable variable, int interval,
+                           std::size_t capacity)
+    : neurons_(std::move(neurons)), variable_(variable),
+      interval_(std::max(interval, 1)), capacity_(capacity),
+      values_(capacity * neurons_.size(), 0.0), steps_(capacity, 0)
+{}
+
+void StateMonitor::record(std::uint32_t step, const NeuronPopulation& population)
+{
+    if (capacity_ == 0 || step % interval_ != 0) return;
+
+    double* out = nextRow(step);
+    if (population.precision() == NeuronPopulation::Precision::Float) gather<float>(population, out);
+    else gather<double>(population, out);
+}
+
+void StateMonitor::record(std::uint32_t step, const std::vector<NeuronPopulation>& populations,
+                          const std::vector<int>& offsets)
+{
+    if (populations.size() == 1) {
+        record(step, populations.front());
+        return;
+    }
+    if (capacity_ == 0 || step % interval_ != 0) return;
+
+    double* out = nextRow(step);
+    for (int idx : neurons_) {
+        auto k = std::upper_bound(offsets.begin() + 1, offsets.end() - 1, idx) - offsets.begin() - 1;
+        *out++ = value(populations[k], static_cast<std::size_t>(idx - offsets[k]));
+    }
+}
+
+double* StateMonitor::nextRow(std::uint32_t step)
+{
+    double* row = values_.data() + next_ * neurons_.size();
+    steps_[next_] = step;
+    next_ = (next_ + 1) % capacity_;
+    size_ = std::min(size_ + 1, capacity_);
+    ++total_;
+    return row;
+}
+
+double StateMonitor::value(const NeuronPopulation& population, std::size_t idx) const
+{
+    switch (variable_) {
+    case Variable::Recovery: return population.recovery(idx);
+    case Variable::InputCurrent: return population.inputCurrent(idx);
+    default: return population.voltage(idx);
+    }
+}
+
+template <typename T>
+void StateMonitor::gather(const NeuronPopulation& population, double* out) const
+{
+    const T* source = population.voltageData<T>();
+    if (variable_ == Variable::Recovery) source = population.recoveryData<T>();
+    if (variable_ == Variable::InputCurrent) source = population.inputCurrentData<T>();
+    for (int idx : neurons_) {
+        *out++ = source ? source[idx] : 0.0;  // models without a recovery variable
+    }
+}
+
+void StateMonitor::clear()
+{
+    next_ = 0;
+    size_ = 0;
+    total_ = 0;
+}
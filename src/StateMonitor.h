@@ -0,0 +1,110 @@
+/**
+ * @file StateMonitor.h
+ * @brief Records a state variable of selected neurons inside the step loop.
+ * @author Dario Romandini
+ */
+
+#ifndef STATE_MONITOR_H
+#define STATE_MONITOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "NeuronPopulation.h"
+
+/**
+ * @class StateMonitor
+ * @brief Samples one state variable of a neuron subset every few steps.
+ *
+ * Samples go into a ring buffer of capacity() rows, allocated once at
+ * construction: row k holds the value of every monitored neuron, so recording
+ * never allocates. When the buffer is full the oldest sample is overwritten.
+ */
+class StateMonitor
+{
+public:
+    /** @brief State variable recorded by the monitor; InputCurrent is the total input of the step. */
+    enum class Variable { Voltage, Recovery, InputCurrent };
+
+    /**
+     * @brief Construct a monitor with a preallocated buffer.
+     * @param neurons Indices of the monitored neurons.
+     * @param variable Recorded state variable.
+     * @param interval Sampling interval in steps (at least 1).
+     * @param capacity Number of samples kept.
+     */
+    StateMonitor(std::vector<int> neurons, Variable variable, int interval, std::size_t capacity);
+
+    /**
+     * @brief Sample the population if @p step falls on the sampling interval.
+     * @param step Step index of the state.
+     * @param population Population holding the monitored neurons.
+     */
+    void record(std::uint32_t step, const NeuronPopulation& population);
+
+    /**
+     * @brief Sample neurons spread over consecutive populations.
+     * @param step Step index of the state.
+     * @param populations Populations holding the monitored neurons.
+     * @param offsets Index of the first neuron of each population, plus the
+     *        total neuron count.
+     */
+    void record(std::uint32_t step, const std::vector<NeuronPopulation>& populations,
+                const std::vector<int>& offsets);
+
+    /** @brief Drop all samples, keeping the buffer. */
+    void clear();
+
+    /** @return Indices of the monitored neurons. */
+    const std::vector<int>& neurons() const { return neurons_; }
+
+    /** @return Recorded state variable. */
+    Variable variable() const { return variable_; }
+
+    /** @return Sampling interval in steps. */
+    int interval() const { return interval_; }
+
+    /** @return Maximum number of samples kept. */
+    std::size_t capacity() const { return capacity_; }
+
+    /** @return Number of samples held, at most capacity(). */
+    std::size_t size() const { return size_; }
+
+    /** @return Number of samples taken, including overwritten ones. */
+    std::uint64_t totalSamples() const { return total_; }
+
+    /**
+     * @brief Values of one held sample, one per monitored neuron.
+     * @param k Sample index, 0 being the oldest held sample.
+     */
+    const double* sample(std::size_t k) const { return values_.data() + row(k) * neurons_.size(); }
+
+    /** @return Step index of held sample @p k (0 = oldest). */
+    std::uint32_t sampleStep(std::size_t k) const { return steps_[row(k)]; }
+
+private:
+    /** @brief Copy the monitored values from state arrays of scalar type T. */
+    template <typename T>
+    void gather(const NeuronPopulation& population, double* out) const;
+
+    /** @brief Value of the recorded variable of neuron @p idx. */
+    double value(const NeuronPopulation& population, std::size_t idx) const;
+
+    /** @brief Claim the ring row of a sample of @p step. */
+    double* nextRow(std::uint32_t step);
+
+    std::size_t row(std::size_t k) const { return (next_ + capacity_ - size_ + k) % capacity_; }
+
+    std::vector<int> neurons_;
+    Variable variable_;
+    int interval_;
+    std::size_t capacity_;
+
+    std::vector<double> values_;         ///< capacity × neurons, sample-major ring
+    std::vector<std::uint32_t> steps_;   ///< Step index of each ring row
+    std::size_t next_ = 0;               ///< Ring row written next
+    std::size_t size_ = 0;               ///< Rows holding samples
+    std::uint64_t total_ = 0;            ///< Samples taken so far
+};
+
+#endif // STATE_MONITOR_H
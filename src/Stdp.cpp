@@ -0,0 +1,113 @@
+/**
+ * @file Stdp.cpp
+ * @brief Implements event-driven STDP weight updates and lazily decayed traces.
+ * @author Dario Romandini
+ */
+
+#include "Stdp.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+Stdp::Stdp(const StdpRule& rule, double dt, std::size_t neuronCount)
+    : rule_(rule),
+      pre_(neuronCount, 0.0), post_(neuronCount, 0.0),
+      preStep_(neuronCount, 0), postStep_(neuronCount, 0),
+      preDecay_(decayFor(dt, rule.tauPlus)), postDecay_(decayFor(dt, rule.tauMinus)),
+      inOffsets_(neuronCount + 1, 0)
+{
+    if (!(rule.wMin <= rule.wMax)) {
+        throw std::invalid_argument("STDP needs wMin <= wMax");
+    }
+}
+
+Stdp::Decay Stdp::decayFor(double dt, double tau)
+{
+    if (!(dt > 0.0) || !(tau > 0.0)) {
+        throw std::invalid_argument("STDP needs a positive dt and positive time constants");
+    }
+    Decay decay{{}, dt / tau, true};
+    for (std::size_t age = 0; age < maxDecayTable; ++age) {
+        double factor = std::exp(-static_cast<double>(age) * decay.rate);
+        if (factor < 1e-12) {
+            decay.capped = false;
+            break;
+        }
+        decay.table.push_back(factor);
+    }
+    return decay;
+}
+
+void Stdp::index(const SynapseMatrix& matrix, int srcBegin, int srcEnd)
+{
+    srcBegin_ = srcBegin;
+    srcEnd_ = srcEnd;
+
+    // Counting sort of the plastic synapses by target; rows are visited in
+    // order, so each target lists its sources in ascending order.
+    const int n = matrix.neuronCount();
+    inOffsets_.assign(n + 1, 0);
+    for (int src = srcBegin; src < srcEnd; ++src) {
+        matrix.forEachInRow(src, [&](std::size_t, int dst) { ++inOffsets_[dst + 1]; });
+    }
+    for (int i = 0; i < n; ++i) {
+        inOffsets_[i + 1] += inOffsets_[i];
+    }
+
+    inSynapses_.resize(inOffsets_.back());
+    inSources_.resize(inOffsets_.back());
+    std::vector<std::size_t> next(inOffsets_.begin(), inOffsets_.end() - 1);
+    for (int src = srcBegin; src < srcEnd; ++src) {
+        matrix.forEachInRow(src, [&](std::size_t k, int dst) {
+            std::size_t slot = next[dst]++;
+            inSynapses_[slot] = k;
+            inSources_[slot] = src;
+        });
+    }
+}
+
+void Stdp::apply(std::uint32_t step, const std::vector<int>& fired, SynapseMatrix& matrix,
+                 int dstBegin, int dstEnd) const
+{
+    // Presynaptic spikes: depress the outgoing synapses by the target's trace.
+    for (int src : fired) {
+        if (src < srcBegin_ || src >= srcEnd_) continue;
+        matrix.forEachInRow(src, dstBegin, dstEnd, [&](std::size_t k, int dst) {
+            const double y = decayed(post_[dst], postStep_[dst], step, postDecay_);
+            matrix.setWeight(k, std::clamp(matrix.weight(k) - rule_.aMinus * y,
+                                           rule_.wMin, rule_.wMax));
+        });
+    }
+
+    // Postsynaptic spikes: potentiate the incoming synapses by the source's trace.
+    for (int dst : fired) {
+        if (dst < dstBegin || dst >= dstEnd) continue;
+        for (std::size_t j = inOffsets_[dst]; j < inOffsets_[dst + 1]; ++j) {
+            const int src = inSources_[j];
+            const std::size_t k = inSynapses_[j];
+            const double x = decayed(pre_[src], preStep_[src], step, preDecay_);
+            matrix.setWeight(k, std::clamp(matrix.weight(k) + rule_.aPlus * x,
+                                           rule_.wMin, rule_.wMax));
+        }
+    }
+}
+
+void Stdp::record(std::uint32_t step, const std::vector<int>& fired)
+{
+    for (int idx : fired) {
+        pre_[idx] = decayed(pre_[idx], preStep_[idx], step, preDecay_) + 1.0;
+        post_[idx] = decayed(post_[idx], postStep_[idx], step, postDecay_) + 1.0;
+        preStep_[idx] = step;
+        postStep_[idx] = step;
+    }
+}
+
+double Stdp::preTrace(int idx, std::uint32_t step) const
+{
+    return decayed(pre_[idx], preStep_[idx], step, preDecay_);
+}
+
+double Stdp::postTrace(int idx, std::uint32_t step) const
+{
+    return decayed(post_[idx], postStep_[idx], step, postDecay_);
+}
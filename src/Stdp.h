@@ -0,0 +1,145 @@
+/**
+ * @file Stdp.h
+ * @brief Event-driven spike-timing-dependent plasticity with per-neuron traces.
+ * @author Dario Romandini
+ */
+
+#ifndef STDP_H
+#define STDP_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SynapseMatrix.h"
+
+/**
+ * @struct StdpRule
+ * @brief Parameters of additive pair-based STDP.
+ *
+ * A presynaptic spike followed by a postsynaptic one after Δt potentiates
+ * the synapse by aPlus·exp(-Δt/tauPlus); the reverse order depresses it by
+ * aMinus·exp(-Δt/tauMinus). Contributions of all pairs add up, and weights
+ * are clamped to [wMin, wMax].
+ */
+struct StdpRule
+{
+    double aPlus = 0.01;     ///< Potentiation amplitude (nA)
+    double aMinus = 0.012;   ///< Depression amplitude (nA)
+    double tauPlus = 20.0;   ///< Time constant of the presynaptic trace (ms)
+    double tauMinus = 20.0;  ///< Time constant of the postsynaptic trace (ms)
+    double wMin = 0.0;       ///< Lower weight bound (nA)
+    double wMax = 10.0;      ///< Upper weight bound (nA)
+};
+
+/**
+ * @class Stdp
+ * @brief Applies an StdpRule to the weights of a SynapseMatrix on spike events only.
+ *
+ * Every neuron carries a presynaptic trace x and a postsynaptic trace y,
+ * each stored with the step it was last incremented and decayed lazily
+ * when read, so neurons and synapses without spikes cost nothing per step.
+ * A spike of neuron i depresses the outgoing synapses i→j by aMinus·y_j,
+ * walking row i of the matrix, and potentiates the incoming synapses k→i by
+ * aPlus·x_k, walking a reverse (by target) index of the matrix. The traces
+ * of the spiking neurons are incremented afterwards, so neurons firing in
+ * the same step do not interact. The cost per step is O(spikes × fan-in/out).
+ *
+ * Only the synapses of the sources selected by index() are plastic, so
+ * e.g. inhibitory projections can keep fixed negative weights. The reverse
+ * index must be rebuilt with index() whenever synapses are added; weight
+ * changes do not invalidate it.
+ */
+class Stdp
+{
+public:
+    /**
+     * @brief Construct plasticity state with all traces at zero.
+     * @param rule STDP parameters.
+     * @param dt Time step in milliseconds.
+     * @param neuronCount Number of neurons.
+     * @throws std::invalid_argument unless dt and both time constants are positive
+     *         and wMin <= wMax.
+     */
+    Stdp(const StdpRule& rule, double dt, std::size_t neuronCount);
+
+    /**
+     * @brief Rebuild the reverse index for the synapses of @p matrix.
+     * @param matrix Connectivity whose weights apply() updates.
+     * @param srcBegin First source neuron with plastic synapses.
+     * @param srcEnd One past the last source neuron with plastic synapses.
+     */
+    void index(const SynapseMatrix& matrix, int srcBegin, int srcEnd);
+
+    /**
+     * @brief Update the weights of synapses onto [dstBegin, dstEnd) for the spikes of a step.
+     *
+     * Workers owning disjoint target ranges can call this concurrently;
+     * every synapse receives its updates in the same order for any
+     * partition.
+     *
+     * @param step Step of the spikes.
+     * @param fired Neurons that spiked, in ascending order.
+     * @param matrix Matrix indexed by index().
+     * @param dstBegin First target index handled.
+     * @param dstEnd One past the last target index handled.
+     */
+    void apply(std::uint32_t step, const std::vector<int>& fired, SynapseMatrix& matrix,
+               int dstBegin, int dstEnd) const;
+
+    /**
+     * @brief Add the spikes of a step to the traces, after apply().
+     * @param step Step of the spikes.
+     * @param fired Neurons that spiked.
+     */
+    void record(std::uint32_t step, const std::vector<int>& fired);
+
+    /** @return Presynaptic trace of neuron @p idx at @p step. */
+    double preTrace(int idx, std::uint32_t step) const;
+
+    /** @return Postsynaptic trace of neuron @p idx at @p step. */
+    double postTrace(int idx, std::uint32_t step) const;
+
+    /** @return STDP parameters. */
+    const StdpRule& rule() const { return rule_; }
+
+private:
+    /// Longest decay table; older traces are decayed with std::exp.
+    static constexpr std::size_t maxDecayTable = 4096;
+
+    /** @brief Decay factors exp(-age·dt/tau) of one trace, zero once below 1e-12. */
+    struct Decay
+    {
+        std::vector<double> table;  ///< Factor per age, up to maxDecayTable entries
+        double rate;                ///< dt / tau
+        bool capped;                ///< The table ends before the factor drops below 1e-12
+    };
+
+    /** @brief Tabulate the decay of a trace with time constant @p tau. */
+    static Decay decayFor(double dt, double tau);
+
+    /** @brief Trace decayed from @p last to @p step. */
+    static double decayed(double trace, std::uint32_t last, std::uint32_t step, const Decay& decay)
+    {
+        const std::uint32_t age = step - last;
+        if (age < decay.table.size()) return trace * decay.table[age];
+        if (!decay.capped) return 0.0;
+        const double factor = std::exp(-static_cast<double>(age) * decay.rate);
+        return factor < 1e-12 ? 0.0 : trace * factor;
+    }
+
+    StdpRule rule_;
+    std::vector<double> pre_;                ///< Presynaptic trace at its last spike
+    std::vector<double> post_;               ///< Postsynaptic trace at its last spike
+    std::vector<std::uint32_t> preStep_;     ///< Step of the last presynaptic increment
+    std::vector<std::uint32_t> postStep_;    ///< Step of the last postsynaptic increment
+    Decay preDecay_;                         ///< exp(-age·dt/tauPlus)
+    Decay postDecay_;                        ///< exp(-age·dt/tauMinus)
+    int srcBegin_ = 0;                       ///< First source of plastic synapses
+    int srcEnd_ = 0;                         ///< One past the last source of plastic synapses
+    std::vector<std::size_t> inOffsets_;     ///< Reverse index offsets, size neuronCount + 1
+    std::vector<std::size_t> inSynapses_;    ///< Incoming synapse ids, by target then source
+    std::vector<int> inSources_;             ///< Source of each incoming synapse
+};
+
+#endif // STDP_H
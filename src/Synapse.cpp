@@ -6,8 +6,8 @@
 
 #include "Synapse.h"
 
-Synapse::Synapse(int srcIndex, int dstIndex, double weight)
-    : src_(srcIndex), dst_(dstIndex), weight_(weight)
+Synapse::Synapse(int srcIndex, int dstIndex, double weight, int delay)
+    : src_(srcIndex), dst_(dstIndex), weight_(weight), delay_(delay)
 {}
 
 void Synapse::propagate(const std::vector<std::unique_ptr<Neuron>>& neurons) const
@@ -17,8 +17,16 @@ void Synapse::propagate(const std::vector<std::unique_ptr<Neuron>>& neurons) con
     }
 }
 
+void Synapse::propagate(NeuronPopulation& population) const
+{
+    if (population.hasSpiked(src_)) {
+        population.receiveSynapticCurrent(dst_, weight_, delay_);
+    }
+}
+
 int Synapse::src() const { return src_; }
 int Synapse::dst() const { return dst_; }
 double Synapse::weight() const { return weight_; }
+int Synapse::delay() const { return delay_; }
 
 void Synapse::setWeight(double w) { weight_ = w; }
@@ -11,12 +11,15 @@
 #include <memory>
 #include <vector>
 #include "Neuron.h"
+#include "NeuronPopulation.h"
 
 /**
  * @class Synapse
  * @brief Models a directed synapse between two neurons.
  *
  * Delivers a fixed-weighted current to the destination neuron if the source neuron spikes.
+ * The current arrives after an axonal delay counted in simulation steps; the
+ * minimum delay of one step means it is integrated by the next update.
  */
 class Synapse
 {
@@ -26,15 +29,25 @@ public:
      * @param srcIndex Index of the source neuron.
      * @param dstIndex Index of the destination neuron.
      * @param weight Synaptic weight (nA).
+     * @param delay Transmission delay in simulation steps (>= 1).
      */
-    Synapse(int srcIndex, int dstIndex, double weight);
+    Synapse(int srcIndex, int dstIndex, double weight, int delay = 1);
 
     /**
      * @brief Propagate a spike from source to destination if source neuron has spiked.
+     *
+     * Neuron objects have no input queue, so the delay is not applied here.
+     *
      * @param neurons Vector of neuron pointers.
      */
     void propagate(const std::vector<std::unique_ptr<Neuron>>& neurons) const;
 
+    /**
+     * @brief Propagate a spike within a population if the source neuron has spiked.
+     * @param population Population holding both neurons.
+     */
+    void propagate(NeuronPopulation& population) const;
+
     /** @return Index of the source neuron. */
     int src() const;
 
@@ -44,6 +57,9 @@ public:
     /** @return Synaptic weight in nanoamperes (nA). */
     double weight() const;
 
+    /** @return Transmission delay in simulation steps. */
+    int delay() const;
+
     /** @brief Set the synaptic weight. */
     void setWeight(double w);
 
@@ -56,6 +72,7 @@ private:
     int src_;         ///< Source neuron index
     int dst_;         ///< Destination neuron index
     double weight_;   ///< Synaptic weight (nA)
+    int delay_;       ///< Transmission delay (steps)
 };
 
 #endif // SYNAPSE_H
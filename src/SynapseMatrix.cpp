@@ -0,0 +1,441 @@
+/**
+ * @file SynapseMatrix.cpp
+ * @brief Implements CSR construction and event-driven spike delivery.
+ * @author Dario Romandini
+ */
+
+#include "SynapseMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+/** @brief IEEE 754 binary16 bits of @p value, rounded to nearest even (via float). */
+std::uint16_t floatToHalf(double value)
+{
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(static_cast<float>(value));
+    const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+    const std::uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude > 0x7f800000u) return sign | 0x7e00u;   // NaN
+    if (magnitude >= 0x47800000u) return sign | 0x7c00u;  // overflow to infinity
+    if (magnitude < 0x38800000u) {
+        // Subnormal half: a multiple of 2^-24, rounded by the FPU.
+        const float scaled = std::bit_cast<float>(magnitude) * 0x1p24f;
+        return sign | static_cast<std::uint16_t>(std::nearbyint(scaled));
+    }
+    std::uint32_t half = ((magnitude >> 23) - 112) << 10 | (magnitude >> 13 & 0x3ffu);
+    const std::uint32_t rest = magnitude & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;  // may carry into infinity
+    return sign | static_cast<std::uint16_t>(half);
+}
+
+/** @brief Sorted distinct values of @p weights, at most 256 of them. */
+std::vector<double> distinctWeights(std::vector<double> weights)
+{
+    std::sort(weights.begin(), weights.end());
+    weights.erase(std::unique(weights.begin(), weights.end()), weights.end());
+    weights.shrink_to_fit();
+    if (weights.size() > 256) {
+        throw std::invalid_argument("shared weights need at most 256 distinct values, got " +
+                                    std::to_string(weights.size()));
+    }
+    return weights;
+}
+
+} // namespace
+
+SynapseMatrix::SynapseMatrix(int neuronCount)
+    : offsets_(static_cast<std::size_t>(neuronCount) + 1, 0)
+{}
+
+void SynapseMatrix::append(const std::vector<Synapse>& synapses)
+{
+    if (synapses.empty()) return;
+    if (weightEncoding_ == WeightEncoding::Shared) {
+        std::vector<double> added;
+        added.reserve(synapses.size());
+        for (const auto& syn : synapses) added.push_back(syn.weight());
+        checkWeightTable(added);
+    }
+
+    // Merge plain targets and double weights, then restore the encodings.
+    const TargetEncoding encoding = encoding_;
+    const WeightEncoding weightEncoding = weightEncoding_;
+    setTargetEncoding(TargetEncoding::Plain);
+    unpackWeights();
+
+    const int n = neuronCount();
+    const std::size_t total = synapseCount() + synapses.size();
+
+    // Existing synapses (row order) followed by the new ones (insertion order).
+    std::vector<int> srcs(total), dsts(total);
+    std::vector<double> weights(total);
+    std::vector<std::uint16_t> delays(total);
+    std::size_t k = 0;
+    for (int i = 0; i < n; ++i) {
+        for (std::size_t j = rowBegin(i); j < rowEnd(i); ++j, ++k) {
+            srcs[k] = i;
+            dsts[k] = targets_[j];
+            weights[k] = weights_[j];
+            delays[k] = delays_[j];
+        }
+    }
+    for (const auto& syn : synapses) {
+        srcs[k] = syn.src();
+        dsts[k] = syn.dst();
+        weights[k] = syn.weight();
+        delays[k] = static_cast<std::uint16_t>(syn.delay());
+        maxDelay_ = std::max(maxDelay_, syn.delay());
+        ++k;
+    }
+
+    // Two stable counting sorts (by target, then by source) leave every row
+    // sorted by target while keeping the order of parallel synapses.
+    std::vector<std::size_t> order(total);
+    {
+        std::vector<std::size_t> cursor(n + 1, 0);
+        for (int dst : dsts) ++cursor[dst + 1];
+        for (int i = 0; i < n; ++i) cursor[i + 1] += cursor[i];
+        for (std::size_t e = 0; e < total; ++e) order[cursor[dsts[e]]++] = e;
+    }
+
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (int src : srcs) ++offsets[src + 1];
+    for (int i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+
+    std::vector<int> targets(total);
+    std::vector<double> sortedWeights(total);
+    std::vector<std::uint16_t> sortedDelays(total);
+    std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t e : order) {
+        std::size_t pos = cursor[srcs[e]]++;
+        targets[pos] = dsts[e];
+        sortedWeights[pos] = weights[e];
+        sortedDelays[pos] = delays[e];
+    }
+
+    offsets_ = std::move(offsets);
+    targets_ = std::move(targets);
+    weights_ = std::move(sortedWeights);
+    delays_ = std::move(sortedDelays);
+    setTargetEncoding(encoding);
+    packWeights(weightEncoding);
+}
+
+void SynapseMatrix::append(SynapseRows rows)
+{
+    if (rows.targets.empty()) return;
+    if (weightEncoding_ == WeightEncoding::Shared) checkWeightTable(rows.weights);
+
+    for (std::uint16_t d : rows.delays) {
+        maxDelay_ = std::max<int>(maxDelay_, d);
+    }
+
+    const TargetEncoding encoding = encoding_;
+    const WeightEncoding weightEncoding = weightEncoding_;
+    if (synapseCount() == 0) {
+        offsets_ = std::move(rows.offsets);
+        targets_ = std::move(rows.targets);
+        weights_ = std::move(rows.weights);
+        delays_ = std::move(rows.delays);
+        encoding_ = TargetEncoding::Plain;
+        weightEncoding_ = WeightEncoding::Double;
+        setTargetEncoding(encoding);
+        packWeights(weightEncoding);
+        return;
+    }
+    setTargetEncoding(TargetEncoding::Plain);
+    unpackWeights();
+
+    const int n = neuronCount();
+    const std::size_t total = synapseCount() + rows.targets.size();
+    std::vector<std::size_t> offsets(n + 1, 0);
+    std::vector<int> targets(total);
+    std::vector<double> weights(total);
+    std::vector<std::uint16_t> delays(total);
+
+    // Merge each old row with its new row; old synapses win ties.
+    std::size_t pos = 0;
+    for (int i = 0; i < n; ++i) {
+        std::size_t a = rowBegin(i), aEnd = rowEnd(i);
+        std::size_t b = rows.offsets[i], bEnd = rows.offsets[i + 1];
+        while (a < aEnd || b < bEnd) {
+            if (b == bEnd || (a < aEnd && targets_[a] <= rows.targets[b])) {
+                targets[pos] = targets_[a];
+                weights[pos] = weights_[a];
+                delays[pos] = delays_[a];
+                ++a;
+            } else {
+                targets[pos] = rows.targets[b];
+                weights[pos] = rows.weights[b];
+                delays[pos] = rows.delays[b];
+                ++b;
+            }
+            ++pos;
+        }
+        offsets[i + 1] = pos;
+    }
+
+    offsets_ = std::move(offsets);
+    targets_ = std::move(targets);
+    weights_ = std::move(weights);
+    delays_ = std::move(delays);
+    setTargetEncoding(encoding);
+    packWeights(weightEncoding);
+}
+
+void SynapseMatrix::setTargetEncoding(TargetEncoding encoding)
+{
+    if (encoding == encoding_) return;
+
+    const int n = neuronCount();
+    if (encoding == TargetEncoding::Varint) {
+        // Rows are sorted, so every gap (the first from target 0) is >= 0.
+        std::vector<std::uint8_t> packed;
+        std::vector<std::size_t> packedOffsets(n + 1, 0);
+        std::vector<int> skipTargets;
+        std::vector<std::size_t> skipBytes;
+        packed.reserve(synapseCount());
+        skipTargets.reserve((synapseCount() + skipStride - 1) / skipStride);
+        skipBytes.reserve(skipTargets.capacity());
+        for (int i = 0; i < n; ++i) {
+            int previous = 0;
+            for (std::size_t k = rowBegin(i); k < rowEnd(i); ++k) {
+                if (k % skipStride == 0) {
+                    skipTargets.push_back(previous);
+                    skipBytes.push_back(packed.size());
+                }
+                auto gap = static_cast<std::uint32_t>(targets_[k] - previous);
+                previous = targets_[k];
+                for (; gap >= 0x80; gap >>= 7) {
+                    packed.push_back(static_cast<std::uint8_t>(gap | 0x80));
+                }
+                packed.push_back(static_cast<std::uint8_t>(gap));
+            }
+            packedOffsets[i + 1] = packed.size();
+        }
+        packed.shrink_to_fit();
+        packed_ = std::move(packed);
+        packedOffsets_ = std::move(packedOffsets);
+        skipTargets_ = std::move(skipTargets);
+        skipBytes_ = std::move(skipBytes);
+        targets_ = std::vector<int>();
+    } else {
+        std::vector<int> targets(synapseCount());
+        for (int i = 0; i < n; ++i) {
+            forEachInRow(i, [&](std::size_t k, int target) { targets[k] = target; });
+        }
+        targets_ = std::move(targets);
+        packed_ = std::vector<std::uint8_t>();
+        packedOffsets_ = std::vector<std::size_t>();
+        skipTargets_ = std::vector<int>();
+        skipBytes_ = std::vector<std::size_t>();
+    }
+    encoding_ = encoding;
+}
+
+int SynapseMatrix::decodeTarget(std::size_t k) const
+{
+    const auto row = std::upper_bound(offsets_.begin(), offsets_.end(), k) - offsets_.begin() - 1;
+    const std::uint8_t* p = packed_.data() + packedOffsets_[row];
+    int target = 0;
+    for (std::size_t j = offsets_[row]; j <= k; ++j) {
+        target += static_cast<int>(readVarint(p));
+    }
+    return target;
+}
+
+void SynapseMatrix::setWeightEncoding(WeightEncoding encoding)
+{
+    if (encoding == weightEncoding_) return;
+    if (encoding == WeightEncoding::Shared) checkWeightTable({});
+    unpackWeights();
+    packWeights(encoding);
+}
+
+WeightError SynapseMatrix::weightError() const
+{
+    const std::size_t count = synapseCount();
+    return {errorMax_, count ? std::sqrt(errorSquares_ / static_cast<double>(count)) : 0.0};
+}
+
+void SynapseMatrix::checkWeightTable(const std::vector<double>& weights) const
+{
+    std::vector<double> all;
+    if (weightEncoding_ == WeightEncoding::Shared) {
+        all = weightTable_;
+    } else {
+        all.reserve(synapseCount() + weights.size());
+        for (int i = 0; i < neuronCount(); ++i) {
+            forEachWeighted(i, [&](std::size_t, int, double w) { all.push_back(w); });
+        }
+    }
+    all.insert(all.end(), weights.begin(), weights.end());
+    distinctWeights(std::move(all));
+}
+
+void SynapseMatrix::unpackWeights()
+{
+    if (weightEncoding_ == WeightEncoding::Double) return;
+
+    std::vector<double> weights(synapseCount());
+    for (int i = 0; i < neuronCount(); ++i) {
+        forEachWeighted(i, [&](std::size_t k, int, double w) { weights[k] = w; });
+    }
+    weights_ = std::move(weights);
+    weightTable_ = std::vector<double>();
+    weightCodes_ = std::vector<std::uint8_t>();
+    weightHalves_ = std::vector<std::uint16_t>();
+    weightInt8_ = std::vector<std::int8_t>();
+    rowScales_ = std::vector<double>();
+    weightEncoding_ = WeightEncoding::Double;
+}
+
+void SynapseMatrix::packWeights(WeightEncoding encoding)
+{
+    weightEncoding_ = encoding;
+    if (encoding == WeightEncoding::Double) return;
+
+    const int n = neuronCount();
+    const std::size_t count = synapseCount();
+    switch (encoding) {
+    case WeightEncoding::Double:
+        break;
+    case WeightEncoding::Shared:
+        weightTable_ = distinctWeights(weights_);
+        weightCodes_.resize(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            const auto code = std::lower_bound(weightTable_.begin(), weightTable_.end(), weights_[k]);
+            weightCodes_[k] = static_cast<std::uint8_t>(code - weightTable_.begin());
+        }
+        break;
+    case WeightEncoding::Half:
+        weightHalves_.resize(count);
+        for (std::size_t k = 0; k < count; ++k) weightHalves_[k] = floatToHalf(weights_[k]);
+        break;
+    case WeightEncoding::Int8:
+        weightInt8_.resize(count);
+        rowScales_.assign(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            double largest = 0.0;
+            for (std::size_t k = rowBegin(i); k < rowEnd(i); ++k) {
+                largest = std::max(largest, std::abs(weights_[k]));
+            }
+            const double scale = largest / 127.0;
+            rowScales_[i] = scale;
+            for (std::size_t k = rowBegin(i); k < rowEnd(i); ++k) {
+                const long code = scale > 0.0 ? std::lround(weights_[k] / scale) : 0;
+                weightInt8_[k] = static_cast<std::int8_t>(std::clamp(code, -127L, 127L));
+            }
+        }
+        break;
+    }
+
+    // Error of the decoded weights against the ones just encoded.
+    for (int i = 0; i < n; ++i) {
+        forEachWeighted(i, [&](std::size_t k, int, double w) {
+            const double error = std::abs(w - weights_[k]);
+            errorMax_ = std::max(errorMax_, error);
+            errorSquares_ += error * error;
+        });
+    }
+    weights_ = std::vector<double>();
+}
+
+double SynapseMatrix::decodeWeight(std::size_t k) const
+{
+    switch (weightEncoding_) {
+    case WeightEncoding::Shared:
+        return weightTable_[weightCodes_[k]];
+    case WeightEncoding::Half:
+        return halfToFloat(weightHalves_[k]);
+    case WeightEncoding::Int8: {
+        const auto row = std::upper_bound(offsets_.begin(), offsets_.end(), k) - offsets_.begin() - 1;
+        return rowScales_[row] * weightInt8_[k];
+    }
+    case WeightEncoding::Double:
+        break;
+    }
+    return weights_[k];
+}
+
+void SynapseMatrix::addProjection(const RandomProjection& projection)
+{
+    procedural_.push_back(projection);
+    maxDelay_ = std::max(maxDelay_, projection.delay());
+}
+
+std::size_t SynapseMatrix::proceduralSynapseCount() const
+{
+    std::size_t count = 0;
+    for (const RandomProjection& projection : procedural_) count += projection.synapseCount();
+    return count;
+}
+
+std::size_t SynapseMatrix::memoryBytes() const
+{
+    return offsets_.capacity() * sizeof(std::size_t) +
+           targets_.capacity() * sizeof(int) +
+           packed_.capacity() +
+           packedOffsets_.capacity() * sizeof(std::size_t) +
+           skipTargets_.capacity() * sizeof(int) +
+           skipBytes_.capacity() * sizeof(std::size_t) +
+           weights_.capacity() * sizeof(double) +
+           weightTable_.capacity() * sizeof(double) +
+           weightCodes_.capacity() +
+           weightHalves_.capacity() * sizeof(std::uint16_t) +
+           weightInt8_.capacity() +
+           rowScales_.capacity() * sizeof(double) +
+           delays_.capacity() * sizeof(std::uint16_t) +
+           procedural_.capacity() * sizeof(RandomProjection);
+}
+
+double SynapseMatrix::bytesPerSynapse() const
+{
+    const std::size_t count = synapseCount() + proceduralSynapseCount();
+    return count ? static_cast<double>(memoryBytes()) / static_cast<double>(count) : 0.0;
+}
+
+void SynapseMatrix::deliver(const std::vector<int>& fired, NeuronPopulation& population) const
+{
+    deliver(fired, population, 0, neuronCount());
+}
+
+void SynapseMatrix::deliver(const std::vector<int>& fired, NeuronPopulation& population,
+                            int dstBegin, int dstEnd, int offset) const
+{
+    if (population.precision() == NeuronPopulation::Precision::Float) {
+        deliverTo(fired, population.synapticInputData<float>(), population, dstBegin, dstEnd, offset);
+    } else {
+        deliverTo(fired, population.synapticInputData<double>(), population, dstBegin, dstEnd, offset);
+    }
+}
+
+template <typename T>
+void SynapseMatrix::deliverTo(const std::vector<int>& fired, T* ring,
+                              const NeuronPopulation& population, int dstBegin, int dstEnd,
+                              int offset) const
+{
+    const std::uint16_t* delays = delays_.data();
+
+    const std::size_t n = population.size();
+    const std::size_t slots = population.delaySlots();
+    const std::size_t slot = population.delaySlot();
+
+    for (int src : fired) {
+        forEachProcedural(src, dstBegin, dstEnd, [&](int target, double weight, int delay) {
+            std::size_t s = slot + static_cast<std::size_t>(delay);
+            if (s >= slots) s -= slots;
+            ring[s * n + (target - offset)] += static_cast<T>(weight);
+        });
+        forEachWeighted(src, dstBegin, dstEnd, [&](std::size_t k, int target, double weight) {
+            std::size_t s = slot + delays[k];
+            if (s >= slots) s -= slots;
+            ring[s * n + (target - offset)] += static_cast<T>(weight);
+        });
+    }
+}
@@ -0,0 +1,433 @@
+/**
+ * @file SynapseMatrix.h
+ * @brief Compressed sparse row storage of outgoing synapses for event-driven delivery.
+ * @author Dario Romandini
+ */
+
+#ifndef SYNAPSE_MATRIX_H
+#define SYNAPSE_MATRIX_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "NeuronPopulation.h"
+#include "RandomProjection.h"
+#include "Synapse.h"
+
+/**
+ * @struct SynapseRows
+ * @brief New synapses already grouped by source row, as produced by generators.
+ *
+ * Row i occupies [offsets[i], offsets[i+1]) of the per-synapse arrays and
+ * must be sorted by target.
+ */
+struct SynapseRows
+{
+    std::vector<std::size_t> offsets;   ///< Row offsets, size neuronCount + 1
+    std::vector<int> targets;           ///< Target neuron of each synapse
+    std::vector<double> weights;        ///< Weight of each synapse (nA)
+    std::vector<std::uint16_t> delays;  ///< Delay of each synapse (steps)
+};
+
+/**
+ * @struct WeightError
+ * @brief Deviation of quantized synaptic weights from the double weights they encode.
+ */
+struct WeightError
+{
+    double maxAbs = 0.0;  ///< Largest absolute error of a synapse (nA)
+    double rms = 0.0;     ///< Root mean square error over all synapses (nA)
+};
+
+/**
+ * @class SynapseMatrix
+ * @brief Outgoing connectivity in compressed sparse row (CSR) layout.
+ *
+ * Row i holds the synapses whose source is neuron i: targets and weights
+ * are stored contiguously in [offsets[i], offsets[i+1]). Spike delivery only
+ * walks the rows of neurons that fired, so its cost is O(spikes × fan-out)
+ * instead of O(synapses).
+ *
+ * Every row is sorted by target (stably, so parallel synapses keep their
+ * insertion order). A worker that owns a contiguous range of targets can thus
+ * find its part of a row by binary search, and each target receives its
+ * inputs in the same order no matter how targets are partitioned, which keeps
+ * parallel delivery bit-identical to serial delivery.
+ *
+ * Each synapse also stores its delay in steps; delivery writes into the
+ * matching slot of the target population's synaptic input ring, which must
+ * have at least maxDelay() slots.
+ *
+ * Target indices are stored as 32-bit integers by default. With
+ * TargetEncoding::Varint each row instead stores the gaps between its sorted
+ * targets as LEB128 varints (7 bits per byte), so rows with gaps below 128,
+ * as in random networks with fan-out above 1% or local connectivity, take
+ * one byte per target. Rows are decoded sequentially while delivering, and
+ * a checkpoint every skipStride synapses lets a worker start decoding near
+ * the beginning of its target range. Random access through target() then
+ * costs O(row length).
+ *
+ * Weights are stored as doubles by default. Delivery is memory-bound, so the
+ * other WeightEncoding values trade precision for bytes per synapse: a
+ * one-byte index into a table of distinct weights (exact for networks built
+ * from a few constant-weight projections), IEEE half precision, or int8
+ * codes with one scale per row. Weights are decoded on the fly while
+ * delivering, and weightError() reports the quantization error.
+ *
+ * A matrix can also hold procedural projections (RandomProjection) whose
+ * rows are regenerated from their seed for each spike instead of stored.
+ * For every spiking source, delivery visits its procedural rows (in the
+ * order they were added) before its stored row, so procedural projections
+ * made before any stored synapses deliver exactly like their stored
+ * counterparts.
+ */
+class SynapseMatrix
+{
+public:
+    /** @brief Storage of the target indices. */
+    enum class TargetEncoding
+    {
+        Plain,   ///< One 32-bit index per synapse
+        Varint   ///< Per-row delta-encoded varints
+    };
+
+    /** @brief Storage of the weights. */
+    enum class WeightEncoding
+    {
+        Double,  ///< One double per synapse
+        Shared,  ///< One-byte index into a table of at most 256 distinct weights
+        Half,    ///< IEEE 754 binary16 per synapse
+        Int8     ///< int8 code per synapse times a per-row scale (largest |weight| / 127)
+    };
+
+    /**
+     * @brief Construct an empty matrix.
+     * @param neuronCount Number of source neurons (rows).
+     */
+    explicit SynapseMatrix(int neuronCount = 0);
+
+    /**
+     * @brief Append synapses to the matrix.
+     *
+     * Existing synapses are kept; rows are re-sorted by target with stable
+     * counting sorts, O(rows + synapses).
+     *
+     * @param synapses Synapses to insert; indices must be < neuronCount and
+     *        delays in [1, 65535].
+     * @throws std::invalid_argument if shared weights would exceed 256 distinct
+     *         values; the matrix is then unchanged.
+     */
+    void append(const std::vector<Synapse>& synapses);
+
+    /**
+     * @brief Append synapses that are already in row order.
+     *
+     * Each row of @p rows is merged behind the existing synapses of the same
+     * row with equal target, O(synapses), without the sorting passes of the
+     * Synapse overload. An empty matrix adopts the arrays without copying.
+     *
+     * @param rows New synapses; offsets must have neuronCount() + 1 entries.
+     * @throws std::invalid_argument as for the Synapse overload.
+     */
+    void append(SynapseRows rows);
+
+    /**
+     * @brief Deliver the weights of all outgoing synapses of spiking neurons.
+     * @param fired Indices of neurons that spiked this step.
+     * @param population Population receiving the synaptic current.
+     */
+    void deliver(const std::vector<int>& fired, NeuronPopulation& population) const;
+
+    /**
+     * @brief Deliver spikes only to targets in [dstBegin, dstEnd).
+     *
+     * Workers owning disjoint target ranges can call this concurrently
+     * without synchronization. When the targets are spread over several
+     * populations, each is delivered separately with its range of indices.
+     *
+     * @param fired Indices of neurons that spiked this step.
+     * @param population Population receiving the synaptic current.
+     * @param dstBegin First target index handled.
+     * @param dstEnd One past the last target index handled; the range must
+     *        lie within [offset, offset + population.size()).
+     * @param offset Index of the population's first neuron.
+     */
+    void deliver(const std::vector<int>& fired, NeuronPopulation& population,
+                 int dstBegin, int dstEnd, int offset = 0) const;
+
+    /**
+     * @brief Call fn(k, target) for the synapses of row @p src onto [dstBegin, dstEnd).
+     *
+     * Synapses are visited by target, decoding varint rows on the fly.
+     *
+     * @param src Source neuron (row).
+     * @param dstBegin First target index visited.
+     * @param dstEnd One past the last target index visited.
+     * @param fn Callable taking the synapse id (std::size_t) and its target (int).
+     */
+    template <typename Fn>
+    void forEachInRow(int src, int dstBegin, int dstEnd, Fn&& fn) const
+    {
+        std::size_t k = offsets_[src];
+        const std::size_t end = offsets_[src + 1];
+        if (encoding_ == TargetEncoding::Plain) {
+            const int* targets = targets_.data();
+            if (dstBegin > 0) {
+                k = static_cast<std::size_t>(std::lower_bound(targets + k, targets + end, dstBegin) - targets);
+            }
+            for (; k < end && targets[k] < dstEnd; ++k) fn(k, targets[k]);
+            return;
+        }
+
+        const std::uint8_t* p = packed_.data() + packedOffsets_[src];
+        int target = 0;
+        if (dstBegin > 0) {
+            // Resume at the row's last checkpoint whose preceding target is
+            // below dstBegin, then skip at most skipStride synapses.
+            const auto first = skipTargets_.begin() + (k + skipStride - 1) / skipStride;
+            const auto last = skipTargets_.begin() + (end + skipStride - 1) / skipStride;
+            const auto next = std::partition_point(first, last, [&](int t) { return t < dstBegin; });
+            if (next != first) {
+                const std::size_t c = static_cast<std::size_t>(next - skipTargets_.begin()) - 1;
+                k = c * skipStride;
+                p = packed_.data() + skipBytes_[c];
+                target = skipTargets_[c];
+            }
+        }
+        for (; k < end; ++k) {
+            target += static_cast<int>(readVarint(p));
+            if (target < dstBegin) continue;
+            if (target >= dstEnd) break;
+            fn(k, target);
+        }
+    }
+
+    /**
+     * @brief Call fn(k, target, weight) for the synapses of row @p src onto [dstBegin, dstEnd).
+     *
+     * Like forEachInRow(), with the decoded weight (nA) of each synapse.
+     */
+    template <typename Fn>
+    void forEachWeighted(int src, int dstBegin, int dstEnd, Fn&& fn) const
+    {
+        switch (weightEncoding_) {
+        case WeightEncoding::Double: {
+            const double* weights = weights_.data();
+            forEachInRow(src, dstBegin, dstEnd, [&](std::size_t k, int t) { fn(k, t, weights[k]); });
+            break;
+        }
+        case WeightEncoding::Shared: {
+            const double* table = weightTable_.data();
+            const std::uint8_t* codes = weightCodes_.data();
+            forEachInRow(src, dstBegin, dstEnd, [&](std::size_t k, int t) { fn(k, t, table[codes[k]]); });
+            break;
+        }
+        case WeightEncoding::Half: {
+            const std::uint16_t* halves = weightHalves_.data();
+            forEachInRow(src, dstBegin, dstEnd, [&](std::size_t k, int t) {
+                fn(k, t, static_cast<double>(halfToFloat(halves[k])));
+            });
+            break;
+        }
+        case WeightEncoding::Int8: {
+            const double scale = rowScales_[src];
+            const std::int8_t* codes = weightInt8_.data();
+            forEachInRow(src, dstBegin, dstEnd, [&](std::size_t k, int t) { fn(k, t, scale * codes[k]); });
+            break;
+        }
+        }
+    }
+
+    /** @brief Call fn(k, target) for all synapses of row @p src, by target. */
+    template <typename Fn>
+    void forEachInRow(int src, Fn&& fn) const
+    {
+        forEachInRow(src, 0, std::numeric_limits<int>::max(), std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Call fn(target, weight, delay) for the procedural synapses of @p src onto [dstBegin, dstEnd).
+     *
+     * Projections are visited in the order they were added, each by target.
+     */
+    template <typename Fn>
+    void forEachProcedural(int src, int dstBegin, int dstEnd, Fn&& fn) const
+    {
+        for (const RandomProjection& projection : procedural_) {
+            if (!projection.hasSource(src)) continue;
+            const double weight = projection.weight();
+            const int delay = projection.delay();
+            projection.forEachTarget(src, dstBegin, dstEnd, [&](int t) { fn(t, weight, delay); });
+        }
+    }
+
+    /** @brief Call fn(k, target, weight) for all synapses of row @p src, by target. */
+    template <typename Fn>
+    void forEachWeighted(int src, Fn&& fn) const
+    {
+        forEachWeighted(src, 0, std::numeric_limits<int>::max(), std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Add a projection whose synapses are regenerated on every spike.
+     * @param projection Projection over sources and targets < neuronCount(),
+     *        with its synapse count set.
+     */
+    void addProjection(const RandomProjection& projection);
+
+    /** @return Procedural projections, in the order they were added. */
+    const std::vector<RandomProjection>& projections() const { return procedural_; }
+
+    /** @return Number of synapses of the procedural projections. */
+    std::size_t proceduralSynapseCount() const;
+
+    /**
+     * @brief Change the storage of the target indices.
+     *
+     * Converts the stored synapses in O(synapses); later append() calls keep
+     * the encoding. Delivery results do not depend on it.
+     *
+     * @param encoding New target encoding.
+     */
+    void setTargetEncoding(TargetEncoding encoding);
+
+    /** @return Storage of the target indices. */
+    TargetEncoding targetEncoding() const { return encoding_; }
+
+    /**
+     * @brief Change the storage of the weights.
+     *
+     * Converts the stored synapses in O(synapses); later append() calls keep
+     * the encoding. Only WeightEncoding::Double supports setWeight().
+     *
+     * @param encoding New weight encoding.
+     * @throws std::invalid_argument if WeightEncoding::Shared is requested for
+     *         more than 256 distinct weights; the matrix is then unchanged.
+     */
+    void setWeightEncoding(WeightEncoding encoding);
+
+    /** @return Storage of the weights. */
+    WeightEncoding weightEncoding() const { return weightEncoding_; }
+
+    /**
+     * @brief Error of the stored weights against the double weights they were given as.
+     *
+     * Accumulated over every encoding pass. It is exact unless an append
+     * raises the largest weight of an int8 row. That row is then
+     * re-quantized, and only the extra error of that pass is added.
+     */
+    WeightError weightError() const;
+
+    /** @return Bytes allocated for the synapses, row offsets included. */
+    std::size_t memoryBytes() const;
+
+    /** @return memoryBytes() per synapse, procedural ones included, or 0 without synapses. */
+    double bytesPerSynapse() const;
+
+    /** @return Number of rows (source neurons). */
+    int neuronCount() const { return static_cast<int>(offsets_.size()) - 1; }
+
+    /** @return Total number of stored synapses (procedural ones excluded). */
+    std::size_t synapseCount() const { return offsets_.back(); }
+
+    /** @return Index of the first synapse of row @p src. */
+    std::size_t rowBegin(int src) const { return offsets_[src]; }
+
+    /** @return One past the last synapse of row @p src. */
+    std::size_t rowEnd(int src) const { return offsets_[src + 1]; }
+
+    /** @return Target neuron of synapse @p k; O(row length) for varint rows. */
+    int target(std::size_t k) const
+    {
+        return encoding_ == TargetEncoding::Plain ? targets_[k] : decodeTarget(k);
+    }
+
+    /** @return Weight (nA) of synapse @p k, decoded if quantized. */
+    double weight(std::size_t k) const
+    {
+        return weightEncoding_ == WeightEncoding::Double ? weights_[k] : decodeWeight(k);
+    }
+
+    /** @brief Set the weight (nA) of synapse @p k, e.g. for plasticity; Double weights only. */
+    void setWeight(std::size_t k, double weight) { weights_[k] = weight; }
+
+    /** @return Delay (steps) of synapse @p k. */
+    int delay(std::size_t k) const { return delays_[k]; }
+
+    /** @return Longest synaptic delay in steps (1 for an empty matrix). */
+    int maxDelay() const { return maxDelay_; }
+
+private:
+    /** @brief Read one LEB128 varint and advance @p p past it. */
+    static std::uint32_t readVarint(const std::uint8_t*& p)
+    {
+        std::uint32_t value = *p++;
+        if (value < 0x80) return value;
+        value &= 0x7f;
+        for (int shift = 7;; shift += 7) {
+            const std::uint32_t byte = *p++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) return value;
+        }
+    }
+
+    /// Synapses between checkpoints of varint rows.
+    static constexpr std::size_t skipStride = 64;
+
+    /** @brief Value of IEEE 754 binary16 bits @p h. */
+    static float halfToFloat(std::uint16_t h)
+    {
+        // Rebias the exponent by scaling: exact for normal and subnormal halves.
+        const std::uint32_t magnitude = h & 0x7fffu;
+        std::uint32_t bits = magnitude << 13;
+        float value = std::bit_cast<float>(bits) * 0x1p112f;
+        if (magnitude >= 0x7c00u) value = std::bit_cast<float>(bits | 0x7f800000u);
+        return (h & 0x8000u) ? -value : value;
+    }
+
+    /** @brief Target of synapse @p k of a varint-encoded matrix. */
+    int decodeTarget(std::size_t k) const;
+
+    /** @brief Weight of synapse @p k of a quantized matrix. */
+    double decodeWeight(std::size_t k) const;
+
+    /** @brief Decode quantized weights back into weights_. */
+    void unpackWeights();
+
+    /** @brief Encode weights_ with @p encoding and add the error to the statistics. */
+    void packWeights(WeightEncoding encoding);
+
+    /** @brief Throw unless the shared table can take @p weights as well. */
+    void checkWeightTable(const std::vector<double>& weights) const;
+
+    /** @brief deliver() into the synaptic input ring of scalar type T. */
+    template <typename T>
+    void deliverTo(const std::vector<int>& fired, T* ring, const NeuronPopulation& population,
+                   int dstBegin, int dstEnd, int offset) const;
+
+    std::vector<std::size_t> offsets_;  ///< Row offsets, size neuronCount + 1
+    std::vector<int> targets_;          ///< Target neuron of each synapse (Plain)
+    std::vector<std::uint8_t> packed_;  ///< Varint target gaps of all rows (Varint)
+    std::vector<std::size_t> packedOffsets_;  ///< Byte offset of each row in packed_ (Varint)
+    std::vector<int> skipTargets_;            ///< Target before every skipStride-th synapse, 0 at a row start (Varint)
+    std::vector<std::size_t> skipBytes_;      ///< Byte offset of every skipStride-th synapse (Varint)
+    TargetEncoding encoding_ = TargetEncoding::Plain;  ///< Storage of the targets
+    std::vector<double> weights_;       ///< Weight of each synapse (nA) (Double)
+    std::vector<double> weightTable_;   ///< Distinct weights, ascending (Shared)
+    std::vector<std::uint8_t> weightCodes_;   ///< Index into weightTable_ of each synapse (Shared)
+    std::vector<std::uint16_t> weightHalves_; ///< binary16 weight of each synapse (Half)
+    std::vector<std::int8_t> weightInt8_;     ///< Code of each synapse (Int8)
+    std::vector<double> rowScales_;           ///< Weight per code unit of each row (Int8)
+    WeightEncoding weightEncoding_ = WeightEncoding::Double;  ///< Storage of the weights
+    double errorMax_ = 0.0;             ///< Largest quantization error so far (nA)
+    double errorSquares_ = 0.0;         ///< Sum of squared quantization errors (nA²)
+    std::vector<std::uint16_t> delays_; ///< Delay of each synapse (steps)
+    std::vector<RandomProjection> procedural_;  ///< Projections regenerated on spikes
+    int maxDelay_ = 1;                  ///< Longest delay (steps)
+};
+
+#endif // SYNAPSE_MATRIX_H
@@ -0,0 +1,103 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implements the persistent fork/join worker pool.
+ * @author Dario Romandini
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int kSpinIterations = 4096;
+
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads - 1);
+    for (int id = 1; id < threads; ++id) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, id);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop_.store(true, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(const std::function<void(int)>& task)
+{
+    if (workers_.empty()) {
+        task(0);
+        return;
+    }
+
+    task_ = &task;
+    pending_.store(static_cast<int>(workers_.size()), std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_all();
+
+    task(0);
+
+    int spins = 0;
+    int pending;
+    while ((pending = pending_.load(std::memory_order_acquire)) != 0) {
+        if (++spins < kSpinIterations) {
+            cpuRelax();
+        } else {
+            pending_.wait(pending, std::memory_order_acquire);
+        }
+    }
+    task_ = nullptr;
+}
+
+void ThreadPool::workerLoop(int id)
+{
+    std::uint64_t seen = 0;
+    for (;;) {
+        int spins = 0;
+        std::uint64_t generation;
+        while ((generation = generation_.load(std::memory_order_acquire)) == seen) {
+            if (++spins < kSpinIterations) {
+                cpuRelax();
+            } else {
+                generation_.wait(seen, std::memory_order_acquire);
+            }
+        }
+        seen = generation;
+
+        if (stop_.load(std::memory_order_relaxed)) return;
+
+        (*task_)(id);
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pending_.notify_one();
+        }
+    }
+}
+
+std::pair<std::size_t, std::size_t> ThreadPool::split(std::size_t n, int parts, int part,
+                                                      std::size_t align)
+{
+    std::size_t blocks = (n + align - 1) / align;
+    std::size_t begin = std::min(n, blocks * part / parts * align);
+    std::size_t end = std::min(n, blocks * (part + 1) / parts * align);
+    return {begin, end};
+}
@@ -0,0 +1,79 @@
+/**
+ * @file ThreadPool.h
+ * @brief Persistent worker pool used to parallelize the simulation step.
+ * @author Dario Romandini
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads executing one task on every worker at a time.
+ *
+ * Workers are created once and reused for every call to run(), which acts as
+ * a fork/join barrier: it returns only after every worker has finished the
+ * task. The calling thread participates as worker 0, so a pool of size 1 has
+ * no extra threads and runs tasks inline. Idle workers spin briefly before
+ * sleeping, which keeps the per-phase latency low when run() is called once
+ * or several times per simulation step. Tasks must not throw.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Construct a pool.
+     * @param threads Total number of threads including the caller;
+     *        0 uses std::thread::hardware_concurrency().
+     */
+    explicit ThreadPool(int threads = 1);
+
+    /** @brief Stops and joins all workers. */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** @return Total number of threads, including the calling thread. */
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * @brief Run task(worker) on every worker and wait for all of them.
+     * @param task Callable receiving the worker index in [0, size()).
+     */
+    void run(const std::function<void(int)>& task);
+
+    /**
+     * @brief Split [0, n) into contiguous, ordered chunks, one per worker.
+     *
+     * Chunk boundaries are multiples of @p align (except the last end), so
+     * vector kernels see full lanes and workers do not share cache lines.
+     *
+     * @param n Number of items.
+     * @param parts Number of chunks.
+     * @param part Chunk index.
+     * @param align Boundary alignment in items.
+     * @return [begin, end) of the chunk.
+     */
+    static std::pair<std::size_t, std::size_t> split(std::size_t n, int parts, int part,
+                                                     std::size_t align = 1);
+
+private:
+    void workerLoop(int id);
+
+    std::vector<std::thread> workers_;
+    const std::function<void(int)>* task_ = nullptr;
+    std::atomic<std::uint64_t> generation_{0};
+    std::atomic<int> pending_{0};
+    std::atomic<bool> stop_{false};
+};
+
+#endif // THREAD_POOL_H
@@ -9,6 +9,7 @@
 #include <QMouseEvent>
 #include <QPainterPath>
 #include <algorithm>
+#include <numeric>
 
 TraceViewWidget::TraceViewWidget(QWidget* parent)
     : QWidget(parent)
@@ -18,10 +19,17 @@ TraceViewWidget::TraceViewWidget(QWidget* parent)
 
 void TraceViewWidget::setSimulation(Simulation* sim)
 {
+    // Monitors of a replaced simulation are destroyed along with it.
+    if (sim == simulation_ && monitor_) {
+        simulation_->removeMonitor(*monitor_);
+    }
     simulation_ = sim;
+    monitor_ = nullptr;
     if (simulation_) {
-        int N = simulation_->neuronCount();
-        voltageBuffers_.assign(N, std::deque<double>());
+        std::vector<int> all(simulation_->neuronCount());
+        std::iota(all.begin(), all.end(), 0);
+        monitor_ = simulation_->addStateMonitor(std::move(all), StateMonitor::Variable::Voltage,
+                                                1, maxBufferSize_);
     }
     updateView();
 }
@@ -41,16 +49,6 @@ void TraceViewWidget::updateView()
 {
     if (!simulation_) return;
 
-    int N = simulation_->neuronCount();
-    for (int i = 0; i < N; ++i) {
-        double v = simulation_->getNeuron(i)->getVoltage();
-        auto& buf = voltageBuffers_[i];
-        buf.push_back(v);
-        if (static_cast<int>(buf.size()) > maxBufferSize_) {
-            buf.pop_front();
-        }
-    }
-
     if (!freeze_) {
         repaint();
     }
@@ -66,7 +64,7 @@ void TraceViewWidget::paintEvent(QPaintEvent*)
 
 void TraceViewWidget::drawTraces(QPainter& p)
 {
-    if (!simulation_) return;
+    if (!simulation_ || !monitor_) return;
 
     int w = width();
     int h = height();
@@ -75,13 +73,13 @@ void TraceViewWidget::drawTraces(QPainter& p)
 
     for (int n = 0; n < totalNeurons; ++n) {
         int idx = (neuronIndex_ < 0 ? n : neuronIndex_);
-        const auto& buf = voltageBuffers_[idx];
-        if (buf.empty()) continue;
+        int samples = static_cast<int>(monitor_->size());
+        if (samples == 0) continue;
 
         QPainterPath path;
-        for (int i = 0; i < static_cast<int>(buf.size()); ++i) {
+        for (int i = 0; i < samples; ++i) {
             double x = (static_cast<double>(i) / (maxBufferSize_ - 1)) * w;
-            double normV = (buf[i] + 80.0) / 100.0;
+            double normV = (monitor_->sample(i)[idx] + 80.0) / 100.0;
             double y = (n + 1) * yStep - normV * yStep;
             if (i == 0) path.moveTo(x, y);
             else        path.lineTo(x, y);
@@ -93,7 +91,7 @@ void TraceViewWidget::drawTraces(QPainter& p)
 
 void TraceViewWidget::drawCursorInfo(QPainter& p)
 {
-    if (!simulation_) return;
+    if (!simulation_ || !monitor_) return;
 
     double tFraction = static_cast<double>(cursorPos_.x()) / width();
     double tMs = tFraction * windowMs_;
@@ -104,11 +102,11 @@ void TraceViewWidget::drawCursorInfo(QPainter& p)
         neuron = std::clamp(int(cursorPos_.y() / double(height()) * total), 0, total - 1);
     }
 
-    const auto& buf = voltageBuffers_[neuron];
-    if (buf.empty()) return;
+    int samples = static_cast<int>(monitor_->size());
+    if (samples == 0) return;
 
-    int sampleIdx = std::clamp(int(tFraction * (buf.size() - 1)), 0, int(buf.size() - 1));
-    double v = buf[sampleIdx];
+    int sampleIdx = std::clamp(int(tFraction * (samples - 1)), 0, samples - 1);
+    double v = monitor_->sample(sampleIdx)[neuron];
 
     QString info = QString("t=%1 ms, n=%2, V=%3 mV")
                        .arg(tMs, 0, 'f', 1)
@@ -8,16 +8,17 @@
 #define TRACEVIEWWIDGET_H
 
 #include <QWidget>
+#include <memory>
 #include <vector>
-#include <deque>
 #include "Simulation.h"
 
 /**
  * @class TraceViewWidget
  * @brief Widget for displaying membrane potential traces of one or more neurons.
  *
- * Displays voltage traces using a circular buffer, with support for individual neuron
- * selection, stacked display, cursor tracking, and live updates.
+ * Displays voltage traces recorded by a StateMonitor inside the simulation step
+ * loop, so no samples are lost between repaints, with support for individual
+ * neuron selection, stacked display, cursor tracking, and live updates.
  */
 class TraceViewWidget : public QWidget
 {
@@ -49,7 +50,7 @@ public:
     int neuronIndex() const;
 
     /**
-     * @brief Append voltage samples and trigger repaint.
+     * @brief Repaint with the samples recorded since the last update.
      */
     void updateView();
 
@@ -66,7 +67,7 @@ private:
     static constexpr double windowMs_ = 200.0;    ///< Trace window in ms.
     static constexpr int maxBufferSize_ = 500;    ///< Max samples to keep.
 
-    std::vector<std::deque<double>> voltageBuffers_; ///< Voltage trace buffers.
+    std::shared_ptr<StateMonitor> monitor_;  ///< Voltage recorder attached to the simulation.
 
     void drawTraces(QPainter& p);
     void drawCursorInfo(QPainter& p);
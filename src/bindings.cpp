@@ -6,6 +6,8 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+#include <algorithm>
 #include <memory>
 
 #include "Neuron.h"
@@ -13,12 +15,112 @@
 #include "IzhikevichNeuron.h"
 #include "Synapse.h"
 #include "Simulation.h"
+#include "Ensemble.h"
+#include "BatchedSimulation.h"
+#include "ModelRegistry.h"
 
 namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace {
+
+/**
+ * @brief Wrap simulation-owned storage in a read-only NumPy array without copying.
+ *
+ * The array holds a reference to @p owner, so the Simulation outlives every
+ * view taken from it. Without an owner the data is copied.
+ */
+template <typename T>
+py::array readOnlyView(const T* data, std::vector<py::ssize_t> shape, py::handle owner)
+{
+    py::array view(py::dtype::of<T>(), std::move(shape), data, owner);
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+/**
+ * @brief Owner of views of a simulation's population storage.
+ *
+ * Keeps the Simulation alive and pins its storage (Simulation::pinStorage()),
+ * so set_populations() raises instead of freeing memory a view still reads.
+ */
+py::capsule storageOwner(py::object self)
+{
+    struct Owner
+    {
+        py::object simulation;
+        std::shared_ptr<const void> pin;
+    };
+    auto* owner = new Owner{self, self.cast<const Simulation&>().pinStorage()};
+    return py::capsule(owner, [](void* p) { delete static_cast<Owner*>(p); });
+}
+
+/**
+ * @brief readOnlyView of a population state array in the population's precision.
+ * @param data Callable taking a scalar tag (double{} or float{}) and returning the array.
+ */
+template <typename Data>
+py::array stateView(const NeuronPopulation& pop, Data data, std::vector<py::ssize_t> shape,
+                    py::handle owner)
+{
+    if (pop.precision() == NeuronPopulation::Precision::Float) {
+        return readOnlyView(data(float{}), std::move(shape), owner);
+    }
+    return readOnlyView(data(double{}), std::move(shape), owner);
+}
+
+/**
+ * @brief View of per-neuron arrays covering all populations of a simulation.
+ *
+ * A single population gives its zero-copy view; with several, the views are
+ * concatenated along the last (neuron) axis into a read-only copy.
+ *
+ * @param view Callable taking a population and returning its view.
+ */
+template <typename View>
+py::array simulationView(py::object self, View view)
+{
+    const auto& sim = self.cast<const Simulation&>();
+    if (sim.populationCount() == 1) return view(sim.population());
+
+    py::list parts;
+    for (int k = 0; k < sim.populationCount(); ++k) parts.append(view(sim.population(k)));
+    py::array joined(py::module_::import("numpy").attr("concatenate")(parts, "axis"_a = -1));
+    joined.attr("flags").attr("writeable") = false;
+    return joined;
+}
+
+/** @brief Spike flags as a bool array (uint8 storage holds only 0 and 1). */
+py::array readOnlyFlags(const std::uint8_t* data, py::ssize_t n, py::handle owner)
+{
+    py::array view(py::dtype("bool"), {n}, {py::ssize_t{1}}, data, owner);
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+} // namespace
 
 PYBIND11_MODULE(neurosim, m) {
     m.doc() = "NeuroSim: Python interface for spiking neural network simulation";
 
+    m.def("neuron_models",
+          []() {
+              // Registered neuron models with their state, parameters and defaults.
+              py::list models;
+              const ModelRegistry& registry = ModelRegistry::instance();
+              for (const std::string& name : registry.names()) {
+                  const ModelDescriptor& model = registry.get(name);
+                  py::dict entry;
+                  entry["name"] = model.name;
+                  entry["state"] = model.stateNames;
+                  entry["params"] = model.paramNames;
+                  entry["defaults"] = model.defaults;
+                  entry["integrators"] = model.integratorCount;
+                  models.append(entry);
+              }
+              return models;
+          });
+
     // Base Neuron class
     py::class_<Neuron, std::shared_ptr<Neuron>>(m, "Neuron")
         .def("update", &Neuron::update, py::arg("dt"))
@@ -27,40 +129,346 @@ PYBIND11_MODULE(neurosim, m) {
         .def("last_spike_time", &Neuron::lastSpikeTime)
         .def("get_voltage", &Neuron::getVoltage);
 
+    // LIF integration schemes
+    py::enum_<LifIntegrator>(m, "LifIntegrator")
+        .value("EULER", LifIntegrator::Euler)
+        .value("EXACT", LifIntegrator::Exact);
+
     // Integrate-and-Fire Neuron
     py::class_<IntegrateAndFireNeuron, Neuron, std::shared_ptr<IntegrateAndFireNeuron>>(m, "IntegrateAndFireNeuron")
-        .def(py::init<double, double, double, double>(),
+        .def(py::init<double, double, double, double, LifIntegrator>(),
              py::arg("v_rest") = -65.0,
              py::arg("v_thresh") = -50.0,
              py::arg("tau") = 20.0,
-             py::arg("reset_v") = -65.0);
+             py::arg("reset_v") = -65.0,
+             py::arg("integrator") = LifIntegrator::Euler);
+
+    // Izhikevich integration schemes
+    py::enum_<IzhikevichIntegrator>(m, "IzhikevichIntegrator")
+        .value("EULER", IzhikevichIntegrator::Euler)
+        .value("EXPONENTIAL_EULER", IzhikevichIntegrator::ExponentialEuler)
+        .value("RK2", IzhikevichIntegrator::RK2)
+        .value("RK4", IzhikevichIntegrator::RK4);
 
     // Izhikevich Neuron
     py::class_<IzhikevichNeuron, Neuron, std::shared_ptr<IzhikevichNeuron>>(m, "IzhikevichNeuron")
-        .def(py::init<double, double, double, double>(),
+        .def(py::init<double, double, double, double, IzhikevichIntegrator, int>(),
              py::arg("a") = 0.02,
              py::arg("b") = 0.2,
              py::arg("c") = -65.0,
-             py::arg("d") = 8.0);
+             py::arg("d") = 8.0,
+             py::arg("integrator") = IzhikevichIntegrator::Euler,
+             py::arg("substeps") = 1);
 
     // Synapse
     py::class_<Synapse>(m, "Synapse")
-        .def(py::init<int, int, double>(), py::arg("src"), py::arg("dst"), py::arg("weight"))
+        .def(py::init<int, int, double, int>(),
+             py::arg("src"), py::arg("dst"), py::arg("weight"), py::arg("delay") = 1)
         .def("src", &Synapse::src)
         .def("dst", &Synapse::dst)
-        .def("weight", &Synapse::weight);
+        .def("weight", &Synapse::weight)
+        .def("delay", &Synapse::delay);
+
+    // Spike retention policy
+    py::enum_<SpikeStore::Retention>(m, "SpikeRetention")
+        .value("KEEP_ALL", SpikeStore::Retention::KeepAll)
+        .value("KEEP_WINDOW", SpikeStore::Retention::KeepWindow)
+        .value("SPILL_TO_DISK", SpikeStore::Retention::SpillToDisk);
+
+    // Monitors (shared with the Simulation, so they outlive remove_monitor();
+    // arrays are chronological copies)
+    py::class_<StateMonitor, std::shared_ptr<StateMonitor>> stateMonitor(m, "StateMonitor");
+    py::enum_<StateMonitor::Variable>(stateMonitor, "Variable")
+        .value("VOLTAGE", StateMonitor::Variable::Voltage)
+        .value("RECOVERY", StateMonitor::Variable::Recovery)
+        .value("INPUT_CURRENT", StateMonitor::Variable::InputCurrent);
+    stateMonitor
+        .def_property_readonly("neurons", &StateMonitor::neurons)
+        .def_property_readonly("total_samples", &StateMonitor::totalSamples)
+        .def("__len__", &StateMonitor::size)
+        .def_property_readonly("steps",
+             [](const StateMonitor& mon) {
+                 py::array_t<std::uint32_t> steps(static_cast<py::ssize_t>(mon.size()));
+                 std::uint32_t* out = steps.mutable_data();
+                 for (std::size_t k = 0; k < mon.size(); ++k) out[k] = mon.sampleStep(k);
+                 return steps;
+             })
+        .def_property_readonly("values",
+             [](const StateMonitor& mon) {
+                 // Shape (samples, monitored neurons), oldest sample first.
+                 const std::size_t width = mon.neurons().size();
+                 py::array_t<double> values({static_cast<py::ssize_t>(mon.size()),
+                                             static_cast<py::ssize_t>(width)});
+                 double* out = values.mutable_data();
+                 for (std::size_t k = 0; k < mon.size(); ++k, out += width) {
+                     std::copy(mon.sample(k), mon.sample(k) + width, out);
+                 }
+                 return values;
+             })
+        .def("clear", &StateMonitor::clear);
+
+    py::class_<SpikeMonitor, std::shared_ptr<SpikeMonitor>>(m, "SpikeMonitor")
+        .def_property_readonly("total_recorded", &SpikeMonitor::totalRecorded)
+        .def("__len__", &SpikeMonitor::size)
+        .def_property_readonly("steps",
+             [](const SpikeMonitor& mon) {
+                 py::array_t<std::uint32_t> steps(static_cast<py::ssize_t>(mon.size()));
+                 std::uint32_t* out = steps.mutable_data();
+                 for (std::size_t k = 0; k < mon.size(); ++k) out[k] = mon.event(k).step;
+                 return steps;
+             })
+        .def_property_readonly("neurons",
+             [](const SpikeMonitor& mon) {
+                 py::array_t<std::uint32_t> ids(static_cast<py::ssize_t>(mon.size()));
+                 std::uint32_t* out = ids.mutable_data();
+                 for (std::size_t k = 0; k < mon.size(); ++k) out[k] = mon.event(k).neuron;
+                 return ids;
+             })
+        .def("clear", &SpikeMonitor::clear);
+
+    // Scalar type of the neuron state
+    py::enum_<NeuronPopulation::Precision>(m, "Precision")
+        .value("DOUBLE", NeuronPopulation::Precision::Double)
+        .value("FLOAT", NeuronPopulation::Precision::Float);
+
+    // Storage of synapse target indices
+    py::enum_<SynapseMatrix::TargetEncoding>(m, "TargetEncoding")
+        .value("PLAIN", SynapseMatrix::TargetEncoding::Plain)
+        .value("VARINT", SynapseMatrix::TargetEncoding::Varint);
+
+    // Storage of synaptic weights
+    py::enum_<SynapseMatrix::WeightEncoding>(m, "WeightEncoding")
+        .value("DOUBLE", SynapseMatrix::WeightEncoding::Double)
+        .value("SHARED", SynapseMatrix::WeightEncoding::Shared)
+        .value("HALF", SynapseMatrix::WeightEncoding::Half)
+        .value("INT8", SynapseMatrix::WeightEncoding::Int8);
+
+    // Lockstep replicas of one network
+    py::class_<BatchedSimulation>(m, "BatchedSimulation")
+        .def(py::init<const Simulation&, int>(), py::arg("prototype"), py::arg("batch"))
+        .def("batch", &BatchedSimulation::batch)
+        .def("neuron_count", &BatchedSimulation::neuronCount)
+        .def("set_input_current", &BatchedSimulation::setInputCurrent, py::arg("current"))
+        .def("set_replica_input", &BatchedSimulation::setReplicaInput,
+             py::arg("replica"), py::arg("current"))
+        .def("set_noise", &BatchedSimulation::setNoise, py::arg("sigma"), py::arg("seed"))
+        .def("step", &BatchedSimulation::step)
+        .def("run",
+             [](BatchedSimulation& s, int steps) {
+                 py::gil_scoped_release release;
+                 s.run(steps);
+             },
+             py::arg("steps"))
+        .def("current_step", &BatchedSimulation::currentStep)
+        .def("spike_count",
+             [](const BatchedSimulation& s, int replica) { return s.spikeStore(replica).size(); },
+             py::arg("replica"))
+        .def_property_readonly("voltages",
+             [](py::object self) {
+                 // Zero-copy read-only view, shape (neurons, replicas).
+                 const auto& s = self.cast<const BatchedSimulation&>();
+                 const auto& pop = s.population();
+                 return stateView(pop, [&](auto t) { return pop.template voltageData<decltype(t)>(); },
+                                  {py::ssize_t(s.neuronCount()), py::ssize_t(s.batch())}, self);
+             });
+
+    // Parameter sweeps
+    py::class_<Ensemble>(m, "Ensemble")
+        .def(py::init([](int nx, int ny, std::vector<double> inputCurrents, std::vector<double> weights,
+                         std::vector<double> probabilities, double duration, double dt, double delay,
+                         std::uint64_t seed, std::vector<int> monitorNeurons, int monitorInterval,
+                         NeuronPopulation::Precision precision, LifIntegrator lifIntegrator) {
+                 EnsembleConfig config;
+                 config.nx = nx;
+                 config.ny = ny;
+                 config.dt = dt;
+                 config.duration = duration;
+                 config.delay = delay;
+                 config.seed = seed;
+                 config.monitorNeurons = std::move(monitorNeurons);
+                 config.monitorInterval = monitorInterval;
+                 config.precision = precision;
+                 config.integrator = lifIntegrator;
+                 return Ensemble(std::move(config), std::move(inputCurrents),
+                                 std::move(weights), std::move(probabilities));
+             }),
+             py::arg("nx"), py::arg("ny"),
+             py::arg("input_currents") = std::vector<double>{0.0},
+             py::arg("weights") = std::vector<double>{1.0},
+             py::arg("probabilities") = std::vector<double>{0.0},
+             py::arg("duration") = 1000.0, py::arg("dt") = 0.1, py::arg("delay") = 0.0,
+             py::arg("seed") = 1, py::arg("monitor_neurons") = std::vector<int>{},
+             py::arg("monitor_interval") = 10,
+             py::arg("precision") = NeuronPopulation::Precision::Double,
+             py::arg("lif_integrator") = LifIntegrator::Euler)
+        .def("__len__", &Ensemble::size)
+        .def("member",
+             [](const Ensemble& e, std::size_t i) {
+                 const EnsembleMember& m = e.member(i);
+                 return py::dict(py::arg("input_current") = m.inputCurrent,
+                                 py::arg("weight") = m.weight,
+                                 py::arg("probability") = m.probability);
+             },
+             py::arg("index"))
+        .def("run",
+             [](const Ensemble& e, int threads) {
+                 EnsembleResult r;
+                 {
+                     py::gil_scoped_release release;
+                     r = e.run(threads);
+                 }
+                 const auto members = static_cast<py::ssize_t>(e.size());
+                 const auto N = static_cast<py::ssize_t>(e.config().nx * e.config().ny);
+                 const auto width = static_cast<py::ssize_t>(e.config().monitorNeurons.size());
+                 auto toArray = [](const auto& values, std::vector<py::ssize_t> shape) {
+                     using T = typename std::decay_t<decltype(values)>::value_type;
+                     py::array_t<T> out(shape);
+                     std::copy(values.begin(), values.end(), out.mutable_data());
+                     return out;
+                 };
+                 return py::dict(
+                     py::arg("spike_counts") = toArray(r.spikeCounts, {members}),
+                     py::arg("mean_rates") = toArray(r.meanRates, {members}),
+                     py::arg("rates") = toArray(r.rates, {members, N}),
+                     py::arg("traces") = toArray(r.traces,
+                                                 {members, static_cast<py::ssize_t>(r.samples), width}));
+             },
+             py::arg("threads") = 0);
+
+    // Spike-timing-dependent plasticity
+    py::class_<StdpRule>(m, "StdpRule")
+        .def(py::init([](double aPlus, double aMinus, double tauPlus, double tauMinus,
+                         double wMin, double wMax) {
+                 return StdpRule{aPlus, aMinus, tauPlus, tauMinus, wMin, wMax};
+             }),
+             py::arg("a_plus") = StdpRule{}.aPlus, py::arg("a_minus") = StdpRule{}.aMinus,
+             py::arg("tau_plus") = StdpRule{}.tauPlus, py::arg("tau_minus") = StdpRule{}.tauMinus,
+             py::arg("w_min") = StdpRule{}.wMin, py::arg("w_max") = StdpRule{}.wMax)
+        .def_readwrite("a_plus", &StdpRule::aPlus)
+        .def_readwrite("a_minus", &StdpRule::aMinus)
+        .def_readwrite("tau_plus", &StdpRule::tauPlus)
+        .def_readwrite("tau_minus", &StdpRule::tauMinus)
+        .def_readwrite("w_min", &StdpRule::wMin)
+        .def_readwrite("w_max", &StdpRule::wMax);
+
+    // Named population of a Simulation
+    py::class_<PopulationConfig>(m, "PopulationConfig")
+        .def(py::init([](std::string name, const std::string& model, int size,
+                         std::vector<double> params, int integrator, int substeps) {
+                 return PopulationConfig{std::move(name), &ModelRegistry::instance().get(model), size,
+                                         std::move(params), integrator, substeps};
+             }),
+             py::arg("name"), py::arg("model") = "lif", py::arg("size") = 0,
+             py::arg("params") = std::vector<double>{}, py::arg("integrator") = 0,
+             py::arg("substeps") = 1)
+        .def_readwrite("name", &PopulationConfig::name)
+        .def_property_readonly("model", [](const PopulationConfig& c) {
+             return c.model ? c.model->name : std::string("lif");
+         })
+        .def_readwrite("size", &PopulationConfig::size)
+        .def_readwrite("params", &PopulationConfig::params)
+        .def_readwrite("integrator", &PopulationConfig::integrator)
+        .def_readwrite("substeps", &PopulationConfig::substeps);
 
     // Simulation
     py::class_<Simulation>(m, "Simulation")
-        .def(py::init<int, int, double>(), py::arg("nx"), py::arg("ny"), py::arg("dt") = 0.1)
+        .def(py::init<int, int, double, int, NeuronPopulation::Precision>(),
+             py::arg("nx"), py::arg("ny"), py::arg("dt") = 0.1, py::arg("threads") = 1,
+             py::arg("precision") = NeuronPopulation::Precision::Double)
+        .def("precision", &Simulation::precision)
+        .def("set_lif_integrator", &Simulation::setLifIntegrator, py::arg("integrator"))
+        .def("lif_integrator", &Simulation::lifIntegrator)
         .def("step", &Simulation::step)
-        .def("connect_random", &Simulation::connectRandom, py::arg("p"), py::arg("weight"))
-        .def("connect_by_proximity", &Simulation::connectByProximity, py::arg("radius"), py::arg("weight"))
+        .def("run",
+             [](Simulation& s, int steps, std::uint64_t maxSpikes, double maxWallSeconds) {
+                 py::gil_scoped_release release;
+                 return s.run(steps, RunLimits{maxSpikes, maxWallSeconds});
+             },
+             py::arg("steps"), py::arg("max_spikes") = 0, py::arg("max_wall_seconds") = 0.0)
+        .def("run_for",
+             [](Simulation& s, double ms, std::uint64_t maxSpikes, double maxWallSeconds) {
+                 py::gil_scoped_release release;
+                 return s.runFor(ms, RunLimits{maxSpikes, maxWallSeconds});
+             },
+             py::arg("ms"), py::arg("max_spikes") = 0, py::arg("max_wall_seconds") = 0.0)
+        .def("set_thread_count", &Simulation::setThreadCount, py::arg("threads"))
+        .def("thread_count", &Simulation::threadCount)
+        .def("set_populations", &Simulation::setPopulations, py::arg("populations"))
+        .def("population_names",
+             [](const Simulation& s) {
+                 std::vector<std::string> names;
+                 for (const PopulationConfig& config : s.populations()) names.push_back(config.name);
+                 return names;
+             })
+        .def("population_range",
+             [](const Simulation& s, const std::string& name) {
+                 return s.populationRange(s.populationIndex(name));
+             },
+             py::arg("name"))
+        .def("connect_random", &Simulation::connectRandom,
+             py::arg("p"), py::arg("weight"), py::arg("delay") = 0.0, py::arg("seed") = py::none(),
+             py::arg("source") = "", py::arg("target") = "")
+        .def("connect_by_proximity", &Simulation::connectByProximity,
+             py::arg("radius"), py::arg("weight"),
+             py::arg("delay") = 0.0, py::arg("delay_per_unit") = 0.0, py::arg("wrap") = false,
+             py::arg("source") = "", py::arg("target") = "")
+        .def("synapse_count", &Simulation::synapseCount)
+        .def("set_target_encoding", &Simulation::setTargetEncoding, py::arg("encoding"))
+        .def("target_encoding", &Simulation::targetEncoding)
+        .def("set_weight_encoding", &Simulation::setWeightEncoding, py::arg("encoding"))
+        .def("weight_encoding", &Simulation::weightEncoding)
+        .def("set_procedural_connectivity", &Simulation::setProceduralConnectivity,
+             py::arg("enabled"))
+        .def("procedural_connectivity", &Simulation::proceduralConnectivity)
+        .def("weight_error",
+             [](const Simulation& s) {
+                 const WeightError error = s.connectivity().weightError();
+                 return py::dict("max_abs"_a = error.maxAbs, "rms"_a = error.rms);
+             })
+        .def("connectivity_bytes", [](const Simulation& s) { return s.connectivity().memoryBytes(); })
+        .def("bytes_per_synapse", [](const Simulation& s) { return s.connectivity().bytesPerSynapse(); })
+        .def("enable_stdp", &Simulation::enableStdp,
+             py::arg("rule") = StdpRule{}, py::arg("source") = "")
+        .def("disable_stdp", &Simulation::disableStdp)
+        .def("weights",
+             [](const Simulation& s) {
+                 // Copy of the synaptic weights, grouped by source in CSR order.
+                 const SynapseMatrix& m = s.connectivity();
+                 py::array_t<double> weights(static_cast<py::ssize_t>(m.synapseCount()));
+                 double* out = weights.mutable_data();
+                 for (int src = 0; src < m.neuronCount(); ++src) {
+                     m.forEachWeighted(src, [&](std::size_t k, int, double w) { out[k] = w; });
+                 }
+                 return weights;
+             })
         .def("neuron_count", &Simulation::neuronCount)
         .def("nx", &Simulation::nx)
         .def("ny", &Simulation::ny)
-        .def("spike_events", &Simulation::spikeEvents, py::return_value_policy::reference_internal)
+        .def("spike_events", &Simulation::spikeEvents)
+        .def("read_spikes",
+             [](const Simulation& s, std::uint32_t cursor) {
+                 // Spikes since cursor as columnar (times, neuron ids) NumPy
+                 // arrays filled in place, plus the cursor for the next call.
+                 const SpikeStore& store = s.spikeStore();
+                 const auto n = static_cast<py::ssize_t>(store.count(cursor, s.currentStep()));
+                 py::array_t<double> times(n);
+                 py::array_t<std::int32_t> neurons(n);
+                 double* t = times.mutable_data();
+                 std::int32_t* id = neurons.mutable_data();
+                 const double dt = s.dt();
+                 store.forEach(cursor, s.currentStep(), [&](const SpikeEvent& ev) {
+                     *t++ = ev.step * dt;
+                     *id++ = static_cast<std::int32_t>(ev.neuron);
+                 });
+                 return py::make_tuple(times, neurons, s.currentStep());
+             },
+             py::arg("cursor") = 0)
+        .def("set_spike_retention", &Simulation::setSpikeRetention,
+             py::arg("retention"), py::arg("window_ms") = 0.0, py::arg("spill_path") = "")
+        .def("current_step", &Simulation::currentStep)
+        .def("track_spike_rate", &Simulation::trackSpikeRate, py::arg("window_ms"))
         .def("get_spike_rate", &Simulation::getSpikeRate, py::arg("neuron_index"), py::arg("window_ms"))
+        .def("get_spike_rates", &Simulation::getSpikeRates, py::arg("window_ms"))
         .def("get_spike_amplitude", &Simulation::getSpikeAmplitude, py::arg("neuron_index"), py::arg("window_ms"))
         .def("get_voltage",
              [](Simulation& s, int idx) {
@@ -68,5 +476,84 @@ PYBIND11_MODULE(neurosim, m) {
              },
              py::arg("neuron_index"))
         .def("set_input_current", &Simulation::setInputCurrent, py::arg("current"))
-        .def("get_neuron", &Simulation::getNeuron, py::arg("index"), py::return_value_policy::reference_internal);
+        .def("add_state_monitor", &Simulation::addStateMonitor,
+             py::arg("neurons"), py::arg("variable") = StateMonitor::Variable::Voltage,
+             py::arg("interval") = 1, py::arg("capacity") = 10000)
+        .def("add_spike_monitor", &Simulation::addSpikeMonitor,
+             py::arg("neurons") = std::vector<int>{}, py::arg("capacity") = 100000)
+        .def("remove_monitor", py::overload_cast<const StateMonitor&>(&Simulation::removeMonitor),
+             py::arg("monitor"))
+        .def("remove_monitor", py::overload_cast<const SpikeMonitor&>(&Simulation::removeMonitor),
+             py::arg("monitor"))
+        // Zero-copy, read-only views of the live state. They reflect every
+        // later step and keep the Simulation alive. While any of them (or a
+        // get_neuron() object) exists, set_populations() raises, as it would
+        // free their storage. With several populations they are read-only
+        // copies instead; use state() for live views of one population.
+        .def_property_readonly("voltages",
+             [](py::object self) {
+                 return simulationView(self, [&](const NeuronPopulation& pop) {
+                     return stateView(pop, [&](auto t) { return pop.template voltageData<decltype(t)>(); },
+                                      {py::ssize_t(pop.size())}, storageOwner(self));
+                 });
+             })
+        .def_property_readonly("recovery",
+             [](py::object self) {
+                 return simulationView(self, [&](const NeuronPopulation& pop) {
+                     if (pop.model().stateIndex("u") < 0) {
+                         // Models without a recovery variable (LIF) read as zeros.
+                         bool single = pop.precision() == NeuronPopulation::Precision::Float;
+                         return py::array(py::module_::import("numpy").attr("zeros")(
+                             pop.size(), single ? "float32" : "float64"));
+                     }
+                     return stateView(pop, [&](auto t) { return pop.template recoveryData<decltype(t)>(); },
+                                      {py::ssize_t(pop.size())}, storageOwner(self));
+                 });
+             })
+        .def_property_readonly("input_currents",
+             [](py::object self) {
+                 // Total input of the last step: external, synaptic and uniform current.
+                 return simulationView(self, [&](const NeuronPopulation& pop) {
+                     return stateView(pop, [&](auto t) { return pop.template inputCurrentData<decltype(t)>(); },
+                                      {py::ssize_t(pop.size())}, storageOwner(self));
+                 });
+             })
+        .def_property_readonly("synaptic_input",
+             [](py::object self) {
+                 // Read-only copy of shape (delay slots, neurons): the ring is
+                 // reallocated when a connect_* call introduces a longer delay.
+                 // Row delay_slot() is consumed next step.
+                 return simulationView(self, [&](const NeuronPopulation& pop) {
+                     return stateView(pop, [&](auto t) { return pop.template synapticInputData<decltype(t)>(); },
+                                      {py::ssize_t(pop.delaySlots()), py::ssize_t(pop.size())}, py::handle());
+                 });
+             })
+        // All populations share one ring length and current slot.
+        .def("delay_slot", [](const Simulation& s) { return s.population().delaySlot(); })
+        .def_property_readonly("spiked",
+             [](py::object self) {
+                 return simulationView(self, [&](const NeuronPopulation& pop) {
+                     return readOnlyFlags(pop.spikeFlagData(), py::ssize_t(pop.size()), storageOwner(self));
+                 });
+             })
+        .def("state",
+             [](py::object self, const std::string& population, const std::string& variable) {
+                 // Zero-copy view of one state variable of one population.
+                 const auto& s = self.cast<const Simulation&>();
+                 const auto& pop = s.population(s.populationIndex(population));
+                 const int k = pop.model().stateIndex(variable);
+                 if (k < 0) throw py::key_error("no state variable " + variable + " in " + population);
+                 return stateView(pop, [&](auto t) { return pop.template stateData<decltype(t)>(k); },
+                                  {py::ssize_t(pop.size())}, storageOwner(self));
+             },
+             py::arg("population"), py::arg("variable") = "v")
+        .def("get_neuron",
+             [](py::object self, int index) {
+                 // A view onto the population storage, pinned like the arrays above.
+                 Neuron* neuron = self.cast<const Simulation&>().getNeuron(index);
+                 py::object view = py::cast(neuron, py::return_value_policy::reference);
+                 py::detail::keep_alive_impl(view, storageOwner(self));
+                 return view;
+             },
+             py::arg("index"));
 }
@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Ensemble.h"
+#include "Simulation.h"
+#include <stdexcept>
+
+namespace {
+
+EnsembleConfig smallConfig()
+{
+    EnsembleConfig config;
+    config.nx = 6;
+    config.ny = 5;
+    config.duration = 30.0;
+    config.seed = 11;
+    config.monitorNeurons = {0, 7};
+    config.monitorInterval = 4;
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Ensemble members match individually run simulations") {
+    Ensemble ensemble(smallConfig(), {14.0, 20.0}, {0.5, 2.0}, {0.1});
+    REQUIRE(ensemble.size() == 4);
+    REQUIRE(ensemble.member(1).inputCurrent == 20.0);
+    REQUIRE(ensemble.member(2).weight == 2.0);
+
+    EnsembleResult result = ensemble.run(3);
+    REQUIRE(result.samples == 75);
+
+    for (std::size_t i = 0; i < ensemble.size(); ++i) {
+        const auto& m = ensemble.member(i);
+        Simulation sim(6, 5, 0.1);
+        sim.connectRandom(m.probability, m.weight, 0.0, 11);
+        sim.setInputCurrent(m.inputCurrent);
+        StateMonitor& mon = *sim.addStateMonitor({0, 7}, StateMonitor::Variable::Voltage, 4, 100);
+        sim.run(300);
+
+        REQUIRE(result.spikeCounts[i] == sim.spikeStore().size());
+        REQUIRE(mon.size() == result.samples);
+        REQUIRE(result.traces[(i * result.samples + 74) * 2 + 1] == mon.sample(74)[1]);
+    }
+    REQUIRE(result.spikeCounts[1] > result.spikeCounts[0]);
+}
+
+TEST_CASE("Ensemble results do not depend on the thread count") {
+    Ensemble ensemble(smallConfig(), {15.0, 18.0, 25.0}, {1.0}, {0.05, 0.2});
+    EnsembleResult a = ensemble.run(1);
+    EnsembleResult b = ensemble.run(4);
+    REQUIRE(a.spikeCounts == b.spikeCounts);
+    REQUIRE(a.rates == b.rates);
+    REQUIRE(a.traces == b.traces);
+}
+
+TEST_CASE("Simulations copy shared connectivity before modifying it") {
+    Simulation a(4, 4), b(4, 4);
+    a.connectByProximity(1.5, 1.0);
+    b.setConnectivity(a.sharedConnectivity());
+    REQUIRE(&a.connectivity() == &b.connectivity());
+
+    b.connectRandom(0.5, 1.0, 0.0, 3);
+    REQUIRE(&a.connectivity() != &b.connectivity());
+    REQUIRE(b.synapseCount() > a.synapseCount());
+}
+
+TEST_CASE("Ensembles and shared connectivity are checked against the network size") {
+    EnsembleConfig config = smallConfig();
+    config.monitorNeurons = {0, 30};
+    REQUIRE_THROWS_AS(Ensemble(config, {10.0}, {1.0}, {0.1}), std::invalid_argument);
+
+    Simulation a(4, 4), b(5, 4);
+    REQUIRE_THROWS_AS(b.setConnectivity(a.sharedConnectivity()), std::invalid_argument);
+}
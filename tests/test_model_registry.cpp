@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ModelRegistry.h"
+#include "NeuronModels.h"
+#include "NeuronPopulation.h"
+#include "IntegrateAndFireNeuron.h"
+#include "PopulationNeuron.h"
+#include "Simulation.h"
+#include <array>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+// Pacemaker: v rises at a constant rate plus the input and fires at 1.
+struct RampModel
+{
+    static constexpr const char* name = "test_ramp";
+    enum class Integrator { Euler };
+    static constexpr int integratorCount = 1;
+    static constexpr std::array<const char*, 1> stateNames{"v"};
+    static constexpr std::array<const char*, 2> paramNames{"rate", "v0"};
+
+    template <typename V> struct State { V v; };
+    template <typename V> struct Params { V rate, v0; };
+
+    template <typename S> static auto stateFields(S& s) { return std::tie(s.v); }
+    template <typename P> static auto paramFields(P& p) { return std::tie(p.rate, p.v0); }
+
+    template <typename T> static Params<T> defaults() { return {T(0.25), T(0.0)}; }
+    template <typename T> static State<T> initialState(const Params<T>& p) { return {p.v0}; }
+
+    template <Integrator I, typename V, typename T>
+    static auto update(State<V>& s, const Params<V>& p, T dt, const V& input)
+    {
+        s.v = s.v + dt * (p.rate + input);
+        auto spike = s.v >= T(1.0);
+        s.v = spike ? p.v0 : s.v;
+        return spike;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Built-in neuron models are registered") {
+    const ModelRegistry& registry = ModelRegistry::instance();
+    REQUIRE(registry.find("lif") == &ModelRegistry::lif());
+    REQUIRE(registry.find("izhikevich") == &ModelRegistry::izhikevich());
+    REQUIRE(registry.find("missing") == nullptr);
+    REQUIRE_THROWS_AS(registry.get("missing"), std::invalid_argument);
+
+    const ModelDescriptor& izh = ModelRegistry::izhikevich();
+    REQUIRE(izh.stateNames == std::vector<std::string>{"v", "u"});
+    REQUIRE(izh.paramIndex("d") == 3);
+    REQUIRE(izh.integratorCount == izhikevichIntegratorCount);
+    REQUIRE(ModelRegistry::lif().stateIndex("u") == -1);
+
+    // The LIF propagator is derived from tau and dt, not a parameter.
+    const ModelDescriptor& lif = ModelRegistry::lif();
+    REQUIRE(lif.paramNames == std::vector<std::string>{"v_rest", "v_thresh", "tau", "reset_v"});
+    REQUIRE(lif.derivedNames == std::vector<std::string>{"decay"});
+    REQUIRE(lif.defaults.size() == lif.paramNames.size());
+    REQUIRE(lif.paramIndex("decay") == -1);
+}
+
+TEST_CASE("Custom models register once under their name") {
+    ModelRegistry& registry = ModelRegistry::instance();
+    const ModelDescriptor& ramp = registry.add<RampModel>();
+    REQUIRE(&registry.add<RampModel>() == &ramp);
+    REQUIRE(&registry.get("test_ramp") == &ramp);
+    REQUIRE(ramp.defaults == std::vector<double>{0.25, 0.0});
+
+    ModelDescriptor clash = describeModel<RampModel>();
+    clash.paramNames = {"slope", "v0"};
+    REQUIRE_THROWS_AS(registry.add(std::move(clash)), std::invalid_argument);
+}
+
+TEST_CASE("Populations of a custom model run the portable kernel") {
+    const ModelDescriptor& ramp = ModelRegistry::instance().add<RampModel>();
+    for (auto precision : {NeuronPopulation::Precision::Double, NeuronPopulation::Precision::Float}) {
+        NeuronPopulation pop(ramp, 3, precision);
+        pop.setParams(1, {0.5});
+        pop.setParams(2, {0.25, 0.5});
+        REQUIRE(pop.voltage(2) == 0.5);
+
+        // dt = 1: neuron 0 fires every 4 steps; 1 and 2 (reset to 0.5) every 2.
+        std::vector<int> counts(3, 0);
+        for (int step = 0; step < 8; ++step) {
+            pop.update(1.0, 0.0, 0, pop.size());
+            for (std::size_t i = 0; i < pop.size(); ++i) counts[i] += pop.hasSpiked(i);
+        }
+        REQUIRE(counts == std::vector<int>{2, 4, 4});
+        REQUIRE(pop.recovery(0) == 0.0);
+        REQUIRE(pop.recoveryData<double>() == nullptr);
+    }
+}
+
+TEST_CASE("Simulation gives custom models a model-agnostic neuron view") {
+    const ModelDescriptor& ramp = ModelRegistry::instance().add<RampModel>();
+    Simulation sim(2, 2, 0.5);
+    sim.setPopulations({{"ramp", &ramp, 2, {0.5}}, {"lif", nullptr, 2}});
+
+    Neuron* custom = sim.getNeuron(1);
+    REQUIRE(dynamic_cast<PopulationNeuron*>(custom) != nullptr);
+    REQUIRE(dynamic_cast<IntegrateAndFireNeuron*>(sim.getNeuron(2)) != nullptr);
+
+    sim.step();
+    REQUIRE(custom->getVoltage() == 0.25);
+    custom->setInputCurrent(1.5);
+    custom->update(0.5);
+    REQUIRE(custom->hasSpiked());
+    REQUIRE(sim.population(0).voltage(1) == 0.0);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Simulation.h"
+#include "SpikeMonitor.h"
+#include "StateMonitor.h"
+#include <stdexcept>
+
+TEST_CASE("StateMonitor samples every interval and keeps the latest samples") {
+    Simulation sim(4, 4, 0.1);
+    sim.setInputCurrent(20.0);
+    StateMonitor& mon = *sim.addStateMonitor({3, 9}, StateMonitor::Variable::Voltage, 5, 10);
+
+    std::vector<double> v3, v9;
+    for (int s = 0; s < 100; ++s) {
+        sim.step();
+        if (s % 5 == 0) {
+            v3.push_back(sim.population().voltage(3));
+            v9.push_back(sim.population().voltage(9));
+        }
+    }
+
+    REQUIRE(mon.totalSamples() == 20);
+    REQUIRE(mon.size() == 10);
+    for (std::size_t k = 0; k < mon.size(); ++k) {
+        REQUIRE(mon.sampleStep(k) == 50 + 5 * k);
+        REQUIRE(mon.sample(k)[0] == v3[10 + k]);
+        REQUIRE(mon.sample(k)[1] == v9[10 + k]);
+    }
+}
+
+TEST_CASE("SpikeMonitor records only the monitored neurons") {
+    Simulation sim(4, 4, 0.1);
+    sim.setInputCurrent(20.0);
+    SpikeMonitor& some = *sim.addSpikeMonitor({2, 5}, 1000);
+    SpikeMonitor& all = *sim.addSpikeMonitor({}, 1000);
+    sim.run(500);
+
+    REQUIRE(all.totalRecorded() == sim.spikeStore().size());
+    REQUIRE(some.size() > 0);
+    for (std::size_t k = 0; k < some.size(); ++k) {
+        REQUIRE((some.event(k).neuron == 2 || some.event(k).neuron == 5));
+    }
+
+    sim.removeMonitor(some);
+    sim.run(10);
+    REQUIRE(all.totalRecorded() == sim.spikeStore().size());
+}
+
+TEST_CASE("Monitors reject neurons outside the network and outlive removal") {
+    Simulation sim(4, 4, 0.1);
+    REQUIRE_THROWS_AS(sim.addSpikeMonitor({3, 16}, 100), std::invalid_argument);
+    REQUIRE_THROWS_AS(sim.addStateMonitor({-1}, StateMonitor::Variable::Voltage, 1, 10),
+                      std::invalid_argument);
+
+    sim.setInputCurrent(20.0);
+    auto mon = sim.addStateMonitor({0, 15}, StateMonitor::Variable::Voltage, 1, 10);
+    sim.run(20);
+    sim.removeMonitor(*mon);
+    sim.run(20);
+    REQUIRE(mon->totalSamples() == 20);
+    REQUIRE(mon->sampleStep(mon->size() - 1) == 19);
+}
+
+TEST_CASE("StateMonitor records the input current the neurons received") {
+    Simulation sim(4, 4, 0.1);
+    sim.setInputCurrent(20.0);
+    StateMonitor& mon = *sim.addStateMonitor({0, 5}, StateMonitor::Variable::InputCurrent, 1, 10);
+
+    for (int s = 0; s < 10; ++s) sim.step();
+
+    REQUIRE(mon.size() == 10);
+    for (std::size_t k = 0; k < mon.size(); ++k) {
+        REQUIRE(mon.sample(k)[0] == 20.0);
+        REQUIRE(mon.sample(k)[1] == 20.0);
+    }
+    REQUIRE(sim.population().inputCurrent(5) == 20.0);
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NeuronKernels.h"
+#include "NeuronPopulation.h"
+#include <random>
+
+namespace {
+
+// Drives a reference (scalar) and a candidate population with identical
+// heterogeneous inputs and requires bit-identical state and spike lists.
+void requireMatchesScalar(NeuronPopulation::Model model, const NeuronKernels& kernels,
+                          NeuronPopulation::Precision precision,
+                          IzhikevichIntegrator integrator = IzhikevichIntegrator::Euler,
+                          int substeps = 1, LifIntegrator lifIntegrator = LifIntegrator::Euler)
+{
+    const std::size_t n = 37;  // not a multiple of any lane count
+    NeuronPopulation ref(model, n, precision);
+    NeuronPopulation pop(model, n, precision);
+    ref.setKernels(NeuronKernels::scalar());
+    pop.setKernels(kernels);
+    ref.setIzhikevichIntegrator(integrator, substeps);
+    pop.setIzhikevichIntegrator(integrator, substeps);
+    ref.setLifIntegrator(lifIntegrator);
+    pop.setLifIntegrator(lifIntegrator);
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<> input(0.0, 40.0);
+    std::vector<int> firedRef, firedPop;
+    for (int step = 0; step < 500; ++step) {
+        for (std::size_t i = 0; i < n; ++i) {
+            double current = input(gen);
+            ref.receiveSynapticCurrent(i, current);
+            pop.receiveSynapticCurrent(i, current);
+        }
+        firedRef.clear();
+        firedPop.clear();
+        ref.update(0.1, 2.0, 0, n, &firedRef);
+        pop.update(0.1, 2.0, 0, n, &firedPop);
+
+        REQUIRE(firedPop == firedRef);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(pop.voltage(i) == ref.voltage(i));
+            REQUIRE(pop.recovery(i) == ref.recovery(i));
+            REQUIRE(pop.hasSpiked(i) == ref.hasSpiked(i));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Scalar kernels are always available") {
+    auto sets = NeuronKernels::available();
+    REQUIRE_FALSE(sets.empty());
+    REQUIRE(sets.front()->isa == NeuronKernels::Isa::Scalar);
+    REQUIRE(NeuronKernels::active().lanes >= 1);
+}
+
+TEST_CASE("Vectorized LIF kernels are bit-identical to the scalar path") {
+    for (const NeuronKernels* kernels : NeuronKernels::available()) {
+        INFO("kernel set: " << kernels->name);
+        for (LifIntegrator integrator : {LifIntegrator::Euler, LifIntegrator::Exact}) {
+            requireMatchesScalar(NeuronPopulation::Model::IntegrateAndFire, *kernels,
+                                 NeuronPopulation::Precision::Double, {}, 1, integrator);
+            requireMatchesScalar(NeuronPopulation::Model::IntegrateAndFire, *kernels,
+                                 NeuronPopulation::Precision::Float, {}, 1, integrator);
+        }
+    }
+}
+
+TEST_CASE("Vectorized Izhikevich kernels are bit-identical to the scalar path") {
+    for (const NeuronKernels* kernels : NeuronKernels::available()) {
+        INFO("kernel set: " << kernels->name);
+        for (int m = 0; m < izhikevichIntegratorCount; ++m) {
+            auto integrator = static_cast<IzhikevichIntegrator>(m);
+            INFO("integrator: " << m);
+            for (int substeps : {1, 3}) {
+                requireMatchesScalar(NeuronPopulation::Model::Izhikevich, *kernels,
+                                     NeuronPopulation::Precision::Double, integrator, substeps);
+                requireMatchesScalar(NeuronPopulation::Model::Izhikevich, *kernels,
+                                     NeuronPopulation::Precision::Float, integrator, substeps);
+            }
+        }
+    }
+}
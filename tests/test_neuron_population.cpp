@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NeuronPopulation.h"
+#include "IntegrateAndFireNeuron.h"
+#include "IzhikevichNeuron.h"
+#include "Simulation.h"
+#include <cmath>
+
+TEST_CASE("NeuronPopulation matches standalone LIF neurons") {
+    NeuronPopulation pop(NeuronPopulation::Model::IntegrateAndFire, 3);
+    IntegrateAndFireNeuron ref;
+    std::vector<int> fired;
+    for (int s = 0; s < 200; ++s) {
+        pop.update(0.1, 40.0, 0, pop.size(), &fired);
+        ref.receiveSynapticCurrent(40.0);
+        ref.update(0.1);
+        for (std::size_t i = 0; i < pop.size(); ++i) {
+            REQUIRE(pop.voltage(i) == ref.getVoltage());
+            REQUIRE(pop.hasSpiked(i) == ref.hasSpiked());
+        }
+    }
+    REQUIRE_FALSE(fired.empty());
+}
+
+TEST_CASE("NeuronPopulation Izhikevich view spikes with strong input") {
+    NeuronPopulation pop(NeuronPopulation::Model::Izhikevich, 2);
+    IzhikevichNeuron view(pop, 1);
+    bool spiked = false;
+    for (int s = 0; s < 100 && !spiked; ++s) {
+        view.setInputCurrent(20.0);
+        view.update(0.1);
+        spiked = view.hasSpiked();
+    }
+    REQUIRE(spiked);
+    REQUIRE_FALSE(pop.hasSpiked(0));
+}
+
+TEST_CASE("Exact LIF propagator matches the analytic solution at large dt") {
+    NeuronPopulation exact(NeuronPopulation::Model::IntegrateAndFire, 1);
+    NeuronPopulation euler(NeuronPopulation::Model::IntegrateAndFire, 1);
+    exact.setLifIntegrator(LifIntegrator::Exact);
+    for (int s = 1; s <= 40; ++s) {  // 40 ms, sub-threshold (v_inf = -55 mV)
+        exact.setInputCurrent(0, 10.0);
+        euler.setInputCurrent(0, 10.0);
+        exact.update(1.0, 0.0, 0, 1);
+        euler.update(1.0, 0.0, 0, 1);
+        const double analytic = -65.0 + 10.0 * (1.0 - std::exp(-s / 20.0));
+        REQUIRE(std::abs(exact.voltage(0) - analytic) < 1e-9);
+    }
+    REQUIRE(std::abs(euler.voltage(0) - (-65.0 + 10.0 * (1.0 - std::exp(-2.0)))) > 1e-2);
+}
+
+TEST_CASE("Exact LIF keeps the firing rate of a fine Euler step at dt = 1 ms") {
+    auto spikes = [](LifIntegrator integrator, double dt) {
+        NeuronPopulation pop(NeuronPopulation::Model::IntegrateAndFire, 1);
+        pop.setLifIntegrator(integrator);
+        std::vector<int> fired;
+        const int steps = static_cast<int>(std::lround(1000.0 / dt));
+        for (int s = 0; s < steps; ++s) pop.update(dt, 20.0, 0, 1, &fired);
+        return static_cast<double>(fired.size());
+    };
+    const double reference = spikes(LifIntegrator::Euler, 0.01);
+    REQUIRE(reference > 30.0);
+    REQUIRE(std::abs(spikes(LifIntegrator::Exact, 1.0) - reference) / reference < 0.05);
+}
+
+TEST_CASE("Izhikevich substeps advance the state by exactly dt") {
+    NeuronPopulation fine(NeuronPopulation::Model::Izhikevich, 1);
+    NeuronPopulation split(NeuronPopulation::Model::Izhikevich, 1);
+    split.setIzhikevichIntegrator(IzhikevichIntegrator::Euler, 10);
+    for (int s = 0; s < 10; ++s) {
+        fine.setInputCurrent(0, 5.0);
+        fine.update(0.1, 0.0, 0, 1);
+    }
+    split.setInputCurrent(0, 5.0);
+    split.update(1.0, 0.0, 0, 1);
+    REQUIRE(split.voltage(0) == fine.voltage(0));
+    REQUIRE(split.recovery(0) == fine.recovery(0));
+}
+
+TEST_CASE("Higher-order Izhikevich integrators converge to a fine reference") {
+    auto simulate = [](IzhikevichIntegrator integrator, int substeps) {
+        NeuronPopulation pop(NeuronPopulation::Model::Izhikevich, 1);
+        pop.setIzhikevichIntegrator(integrator, substeps);
+        for (int s = 0; s < 20; ++s) {  // 10 ms, sub-threshold
+            pop.setInputCurrent(0, 3.5);
+            pop.update(0.5, 0.0, 0, 1);
+        }
+        REQUIRE_FALSE(pop.hasSpiked(0));
+        return pop.voltage(0);
+    };
+    const double reference = simulate(IzhikevichIntegrator::RK4, 100);
+    const double euler = std::abs(simulate(IzhikevichIntegrator::Euler, 1) - reference);
+    const double expEuler = std::abs(simulate(IzhikevichIntegrator::ExponentialEuler, 1) - reference);
+    const double rk2 = std::abs(simulate(IzhikevichIntegrator::RK2, 1) - reference);
+    const double rk4 = std::abs(simulate(IzhikevichIntegrator::RK4, 1) - reference);
+    REQUIRE(rk2 < euler);
+    REQUIRE(rk4 < rk2);
+    REQUIRE(expEuler < euler);
+    REQUIRE(rk4 < 1e-3);
+}
+
+TEST_CASE("Simulation neuron views alias the population state") {
+    Simulation sim(2, 2);
+    sim.setInputCurrent(5.0);
+    sim.step();
+    for (int i = 0; i < sim.neuronCount(); ++i) {
+        REQUIRE(sim.getNeuron(i)->getVoltage() == sim.population().voltage(i));
+    }
+    REQUIRE(sim.getNeuron(1) == sim.getNeuron(1));
+}
+
+TEST_CASE("Input current data holds the total input of the last update") {
+    for (auto precision : {NeuronPopulation::Precision::Double, NeuronPopulation::Precision::Float}) {
+        NeuronPopulation pop(NeuronPopulation::Model::Izhikevich, 3, precision);
+        pop.setInputCurrent(1, 5.0);
+        pop.update(0.1, 10.0, 0, pop.size(), nullptr);
+
+        auto total = [&](std::size_t i) {
+            return precision == NeuronPopulation::Precision::Float
+                ? double(pop.inputCurrentData<float>()[i]) : pop.inputCurrentData<double>()[i];
+        };
+        REQUIRE(total(0) == 10.0);
+        REQUIRE(total(1) == 15.0);
+        REQUIRE(pop.inputCurrent(1) == 15.0);
+
+        pop.update(0.1, 10.0, 0, pop.size(), nullptr);
+        REQUIRE(total(1) == 10.0);
+    }
+}
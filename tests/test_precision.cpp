@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Simulation.h"
+#include <cmath>
+#include <functional>
+
+namespace {
+
+using Precision = NeuronPopulation::Precision;
+
+// Total spikes of a reference network run in the given precision.
+std::size_t spikeCount(Precision precision, const std::function<void(Simulation&)>& build,
+                       double input, int steps)
+{
+    Simulation sim(16, 16, 0.1, 1, precision);
+    build(sim);
+    sim.setInputCurrent(input);
+    sim.run(steps);
+    return sim.spikeStore().size();
+}
+
+void requireCountsClose(const std::function<void(Simulation&)>& build, double input)
+{
+    const std::size_t d = spikeCount(Precision::Double, build, input, 2000);
+    const std::size_t f = spikeCount(Precision::Float, build, input, 2000);
+    INFO("double: " << d << " float: " << f);
+    REQUIRE(d > 0);
+    REQUIRE(std::abs(static_cast<double>(f) - static_cast<double>(d)) <= 0.02 * d + 2);
+}
+
+} // namespace
+
+TEST_CASE("Float populations store single-precision state") {
+    Simulation sim(4, 4, 0.1, 1, Precision::Float);
+    REQUIRE(sim.precision() == Precision::Float);
+    REQUIRE(sim.population().voltageData<float>() != nullptr);
+    REQUIRE(sim.population().voltageData<double>() == nullptr);
+    REQUIRE(sim.population().voltage(0) == -65.0);
+}
+
+TEST_CASE("Float and double spike counts agree on the unconnected grid") {
+    requireCountsClose([](Simulation&) {}, 20.0);
+}
+
+TEST_CASE("Float and double spike counts agree on the proximity network") {
+    requireCountsClose([](Simulation& sim) { sim.connectByProximity(2.5, 0.7, 0.0, 0.2); }, 18.0);
+}
+
+TEST_CASE("Float and double spike counts agree on the random network") {
+    requireCountsClose([](Simulation& sim) { sim.connectRandom(0.05, 0.5, 0.5, 21); }, 18.0);
+}
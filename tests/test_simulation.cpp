@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Simulation.h"
 #include "IntegrateAndFireNeuron.h"
+#include "ModelRegistry.h"
+#include <stdexcept>
 
 TEST_CASE("Simulation initializes correct number of neurons") {
     Simulation sim(5, 4);
@@ -54,3 +56,180 @@ TEST_CASE("Simulation supports connectivity by proximity") {
     sim.connectByProximity(1.5, 0.5);
     REQUIRE(sim.spikeEvents().empty());
 }
+
+TEST_CASE("Simulation produces the same spikes with several threads") {
+    Simulation serial(8, 8, 0.1, 1);
+    Simulation parallel(8, 8, 0.1, 3);
+    REQUIRE(parallel.threadCount() == 3);
+
+    for (Simulation* sim : {&serial, &parallel}) {
+        sim->connectByProximity(1.5, 2.0);
+        sim->setInputCurrent(30.0);
+        for (int i = 0; i < 500; ++i) {
+            sim->step();
+        }
+    }
+    REQUIRE_FALSE(serial.spikeEvents().empty());
+    REQUIRE(serial.spikeEvents() == parallel.spikeEvents());
+}
+
+TEST_CASE("Simulation state is bit-identical for any thread count") {
+    auto run = [](int threads) {
+        Simulation sim(16, 16, 0.1, threads);
+        sim.connectByProximity(2.5, 0.7);
+        sim.setInputCurrent(20.0);
+        for (int i = 0; i < 600; ++i) {
+            sim.step();
+        }
+        std::vector<double> v;
+        for (int i = 0; i < sim.neuronCount(); ++i) {
+            v.push_back(sim.population().voltage(i));
+        }
+        return std::make_pair(v, sim.spikeEvents());
+    };
+
+    const auto reference = run(1);
+    REQUIRE_FALSE(reference.second.empty());
+    for (int threads : {2, 3, 5}) {
+        REQUIRE(run(threads) == reference);
+    }
+}
+
+TEST_CASE("Simulation run matches repeated step calls", "[Simulation]") {
+    Simulation a(8, 8, 0.1), b(8, 8, 0.1);
+    for (auto* sim : {&a, &b}) {
+        sim->connectByProximity(1.5, 0.5);
+        sim->setInputCurrent(20.0);
+    }
+
+    REQUIRE(a.run(250) == 250);
+    for (int i = 0; i < 250; ++i) b.step();
+    REQUIRE(a.currentStep() == b.currentStep());
+    REQUIRE(a.spikeStore().size() == b.spikeStore().size());
+    for (int i = 0; i < 64; ++i) {
+        REQUIRE(a.population().voltage(i) == b.population().voltage(i));
+    }
+
+    REQUIRE(a.runFor(10.0) == 100);
+    REQUIRE(a.currentStep() == 350);
+}
+
+TEST_CASE("Simulation run stops at the spike budget", "[Simulation]") {
+    Simulation sim(8, 8, 0.1);
+    sim.setInputCurrent(20.0);
+
+    RunLimits limits;
+    limits.maxSpikes = 10;
+    int steps = sim.run(100000, limits);
+    REQUIRE(steps < 100000);
+    REQUIRE(sim.spikeStore().size() >= 10);
+    REQUIRE(sim.spikeStore().size() < 10 + 64);
+}
+
+TEST_CASE("Splitting the neurons into populations keeps the dynamics", "[Simulation]") {
+    Simulation whole(12, 12, 0.1), split(12, 12, 0.1);
+    const ModelDescriptor& lif = ModelRegistry::lif();
+    split.setPopulations({{"a", &lif, 37, {}, 0, 1}, {"b", &lif, 144 - 37, {}, 0, 1}});
+    REQUIRE(split.populationCount() == 2);
+    REQUIRE(split.populationRange(1) == std::make_pair(37, 144));
+    REQUIRE(split.populationOf(36) == 0);
+    REQUIRE(split.populationOf(37) == 1);
+
+    for (Simulation* sim : {&whole, &split}) {
+        sim->connectRandom(0.05, 1.5, 0.5, 7);
+        sim->setInputCurrent(18.0);
+        sim->run(400);
+    }
+    REQUIRE(split.synapseCount() == whole.synapseCount());
+    REQUIRE_FALSE(whole.spikeEvents().empty());
+    REQUIRE(split.spikeEvents() == whole.spikeEvents());
+    REQUIRE(split.getNeuron(100)->getVoltage() == whole.population().voltage(100));
+}
+
+TEST_CASE("Heterogeneous populations are bit-identical for any thread count", "[Simulation]") {
+    const ModelDescriptor& izh = ModelRegistry::izhikevich();
+    auto run = [&](int threads) {
+        Simulation sim(16, 16, 0.1, threads);
+        sim.setPopulations({{"exc", &izh, 160, {0.02, 0.2, -65.0, 8.0}, 0, 1},
+                            {"inh", &izh, 40, {0.1, 0.2, -65.0, 2.0}, 3, 2},
+                            {"lif", &ModelRegistry::lif(), 56, {}, 1, 1}});
+        sim.connectRandom(0.1, 2.0, 1.0, 3, "exc");
+        sim.connectRandom(0.1, -4.0, 1.0, 4, "inh", "exc");
+        sim.connectByProximity(1.5, 1.0, 0.5, 0.0, false, "exc", "lif");
+        sim.setInputCurrent(6.0);
+        sim.run(500);
+        std::vector<double> v;
+        for (int i = 0; i < sim.neuronCount(); ++i) v.push_back(sim.getNeuron(i)->getVoltage());
+        return std::make_pair(v, sim.spikeEvents());
+    };
+
+    const auto reference = run(1);
+    REQUIRE_FALSE(reference.second.empty());
+    for (int threads : {2, 3, 5}) {
+        REQUIRE(run(threads) == reference);
+    }
+}
+
+TEST_CASE("Projections only connect the named populations", "[Simulation]") {
+    Simulation sim(10, 10, 0.1, 2);
+    const ModelDescriptor& izh = ModelRegistry::izhikevich();
+    sim.setPopulations({{"exc", &izh, 80, {}, 0, 1}, {"inh", &izh, 20, {}, 0, 1}});
+    sim.connectRandom(0.5, -1.0, 0.0, 11, "inh", "exc");
+    sim.connectByProximity(2.0, 1.0, 0.0, 0.0, true, "exc", "inh");
+
+    const SynapseMatrix& m = sim.connectivity();
+    REQUIRE(m.synapseCount() > 0);
+    for (int src = 0; src < sim.neuronCount(); ++src) {
+        for (std::size_t k = m.rowBegin(src); k < m.rowEnd(src); ++k) {
+            if (src < 80) {
+                REQUIRE(m.target(k) >= 80);
+                REQUIRE(m.weight(k) == 1.0);
+            } else {
+                REQUIRE(m.target(k) < 80);
+                REQUIRE(m.weight(k) == -1.0);
+            }
+        }
+    }
+    REQUIRE_THROWS_AS(sim.connectRandom(0.1, 1.0, 0.0, 1, "missing"), std::invalid_argument);
+}
+
+TEST_CASE("Population layouts must cover the grid with unique names", "[Simulation]") {
+    Simulation sim(4, 4);
+    const ModelDescriptor& lif = ModelRegistry::lif();
+    REQUIRE_THROWS_AS(sim.setPopulations({{"a", &lif, 10, {}, 0, 1}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(sim.setPopulations({{"a", &lif, 8, {}, 0, 1}, {"a", &lif, 8, {}, 0, 1}}),
+                      std::invalid_argument);
+    REQUIRE(sim.populationCount() == 1);
+    REQUIRE(sim.populations().front().name == "neurons");
+}
+
+TEST_CASE("Pinned population storage cannot be reallocated", "[Simulation]") {
+    Simulation sim(4, 4);
+    const ModelDescriptor& lif = ModelRegistry::lif();
+    const double* voltages = sim.population().voltageData<double>();
+    {
+        auto pin = sim.pinStorage();
+        auto again = sim.pinStorage();
+        REQUIRE_THROWS_AS(sim.setPopulations({{"a", &lif, 8, {}, 0, 1}, {"b", &lif, 8, {}, 0, 1}}),
+                          std::logic_error);
+        REQUIRE_THROWS_AS(sim.initializeNeurons(), std::logic_error);
+        sim.step();
+        REQUIRE(sim.population().voltageData<double>() == voltages);
+    }
+    sim.setPopulations({{"a", &lif, 8, {}, 0, 1}, {"b", &lif, 8, {}, 0, 1}});
+    REQUIRE(sim.populationCount() == 2);
+}
+
+TEST_CASE("Populations share one synaptic input slot", "[Simulation]") {
+    Simulation sim(4, 4);
+    const ModelDescriptor& lif = ModelRegistry::lif();
+    sim.setPopulations({{"a", &lif, 8, {}, 0, 1}, {"b", &lif, 8, {}, 0, 1}});
+    sim.connectRandom(0.5, 1.0, 0.2, 3, "a", "b");
+    sim.step();
+    sim.connectRandom(0.5, 1.0, 0.5, 4, "b", "a");
+    for (int k = 0; k < 3; ++k) {
+        REQUIRE(sim.population(1).delaySlots() == sim.population(0).delaySlots());
+        REQUIRE(sim.population(1).delaySlot() == sim.population(0).delaySlot());
+        sim.step();
+    }
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "SpikeRateTracker.h"
+#include "Simulation.h"
+
+TEST_CASE("SpikeRateTracker counts spikes in a sliding window") {
+    SpikeRateTracker tracker(3, 4);
+    for (int step = 0; step < 10; ++step) {
+        std::vector<int> fired;
+        if (step % 2 == 0) fired.push_back(0);
+        fired.push_back(2);
+        tracker.record(fired);
+    }
+
+    // Steps 6..9 remain in the window.
+    REQUIRE(tracker.count(0) == 2);
+    REQUIRE(tracker.count(1) == 0);
+    REQUIRE(tracker.count(2) == 4);
+}
+
+TEST_CASE("Tracked spike rates match the spike store") {
+    Simulation sim(8, 8, 0.1);
+    sim.connectByProximity(1.5, 0.5);
+    sim.setInputCurrent(20.0);
+    for (int i = 0; i < 300; ++i) sim.step();
+
+    // Start tracking mid-run: the tracker is filled from the store.
+    sim.trackSpikeRate(10.0);
+    for (int i = 0; i < 300; ++i) {
+        sim.setInputCurrent(20.0);
+        sim.step();
+    }
+
+    const auto tracked = sim.getSpikeRates(10.0);
+    const auto scanned = sim.getSpikeRates(10.05);  // untracked, rounds to the same 100 steps
+    REQUIRE(tracked.size() == 64);
+
+    double total = 0.0;
+    for (int i = 0; i < 64; ++i) {
+        REQUIRE(tracked[i] == Catch::Approx(scanned[i] * 10.05 / 10.0));
+        REQUIRE(sim.getSpikeRate(i, 10.0) == tracked[i]);
+        total += tracked[i];
+    }
+    REQUIRE(total > 0.0);
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include "SpikeStore.h"
+#include "Simulation.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+TEST_CASE("SpikeStore answers window queries across chunks") {
+    SpikeStore store(10);
+    for (std::uint32_t step = 0; step < 100; ++step) {
+        if (step % 3 == 0) store.record(step, {static_cast<int>(step), 7});
+        else store.record(step, {});
+    }
+
+    REQUIRE(store.size() == 68);
+    REQUIRE(store.count(0, 100) == 68);
+    REQUIRE(store.count(10, 20) == 6);  // steps 12, 15, 18
+
+    auto events = store.range(29, 34);
+    REQUIRE(events.size() == 4);
+    REQUIRE(events[0] == SpikeEvent{30, 30});
+    REQUIRE(events[1] == SpikeEvent{30, 7});
+    REQUIRE(events[3].step == 33);
+}
+
+TEST_CASE("SpikeStore keeps only the configured window") {
+    SpikeStore store(10);
+    store.setRetention(SpikeStore::Retention::KeepWindow, 25);
+    for (std::uint32_t step = 0; step < 100; ++step) {
+        store.record(step, {0});
+    }
+
+    REQUIRE(store.totalRecorded() == 100);
+    REQUIRE(store.count(75, 100) == 25);   // the window itself is intact
+    REQUIRE(store.size() < 40);            // whole chunks before it are gone
+    REQUIRE(store.count(0, 60) == 0);
+}
+
+TEST_CASE("SpikeStore spills evicted chunks to disk") {
+    const std::string path = "neurosim_spill_test.bin";
+    std::remove(path.c_str());
+
+    SpikeStore store(4);
+    store.setRetention(SpikeStore::Retention::SpillToDisk, 8, path);
+    for (std::uint32_t step = 0; step < 32; ++step) {
+        store.record(step, {static_cast<int>(step)});
+    }
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    REQUIRE(in.good());
+    const auto spilled = static_cast<std::size_t>(in.tellg()) / sizeof(SpikeEvent);
+    REQUIRE(spilled + store.size() == 32);
+
+    in.seekg(0);
+    SpikeEvent first{};
+    in.read(reinterpret_cast<char*>(&first), sizeof(first));
+    REQUIRE(first == SpikeEvent{0, 0});
+    in.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("SpikeStore keeps chunks it fails to spill") {
+    if (!std::ifstream("/dev/full").good()) return;  // Needs a device that fails writes
+
+    SpikeStore store(4);
+    store.setRetention(SpikeStore::Retention::SpillToDisk, 8, "/dev/full");
+    std::uint32_t step = 0;
+    REQUIRE_THROWS_AS([&] {
+        for (; step < 32; ++step) store.record(step, {static_cast<int>(step)});
+    }(), std::runtime_error);
+    REQUIRE(store.size() == step + 1);
+}
+
+TEST_CASE("Simulation rejects negative or NaN retention windows") {
+    Simulation sim(2, 2, 0.1);
+    REQUIRE_THROWS_AS(sim.setSpikeRetention(SpikeStore::Retention::KeepWindow, -1.0),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(sim.setSpikeRetention(SpikeStore::Retention::KeepWindow, std::nan("")),
+                      std::invalid_argument);
+    REQUIRE_NOTHROW(sim.setSpikeRetention(SpikeStore::Retention::KeepWindow, 1e12));
+    REQUIRE(sim.spikeStore().retention() == SpikeStore::Retention::KeepWindow);
+}
+
+TEST_CASE("Simulation spike rate uses the retained window") {
+    Simulation sim(1, 1);
+    sim.setSpikeRetention(SpikeStore::Retention::KeepWindow, 100.0);
+    sim.setInputCurrent(100.0);
+    for (int i = 0; i < 5000; ++i) {
+        sim.step();
+    }
+
+    REQUIRE(sim.spikeStore().totalRecorded() > sim.spikeStore().size());
+    REQUIRE(sim.getSpikeRate(0, 50.0) > 0.0);
+    REQUIRE(sim.spikeEvents().size() == sim.spikeStore().size());
+}
+
+TEST_CASE("Simulation readSpikes returns each spike once") {
+    Simulation sim(6, 6, 0.1);
+    sim.setInputCurrent(20.0);
+
+    std::vector<double> times;
+    std::vector<int> neurons;
+    std::uint32_t cursor = 0;
+    for (int poll = 0; poll < 5; ++poll) {
+        sim.run(120);
+        cursor = sim.readSpikes(cursor, times, neurons);
+        REQUIRE(cursor == sim.currentStep());
+    }
+
+    const auto all = sim.spikeEvents();
+    REQUIRE(!all.empty());
+    REQUIRE(times.size() == all.size());
+    for (std::size_t k = 0; k < all.size(); ++k) {
+        REQUIRE(times[k] == all[k].first);
+        REQUIRE(neurons[k] == all[k].second);
+    }
+}
@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "Simulation.h"
+#include "Stdp.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace {
+
+SynapseMatrix singleSynapse(double weight)
+{
+    SynapseMatrix m(2);
+    m.append({Synapse(0, 1, weight)});
+    return m;
+}
+
+} // namespace
+
+TEST_CASE("STDP potentiates pre-before-post and depresses post-before-pre") {
+    StdpRule rule;
+    rule.aPlus = 0.1;
+    rule.aMinus = 0.2;
+    rule.wMax = 10.0;
+
+    SynapseMatrix m = singleSynapse(1.0);
+    Stdp stdp(rule, 0.1, 2);
+    stdp.index(m, 0, 2);
+    for (auto [step, neuron] : {std::pair{10u, 0}, std::pair{60u, 1}}) {
+        std::vector<int> fired{neuron};
+        stdp.apply(step, fired, m, 0, 2);
+        stdp.record(step, fired);
+    }
+    REQUIRE(m.weight(0) == Catch::Approx(1.0 + 0.1 * std::exp(-5.0 / 20.0)));
+
+    SynapseMatrix r = singleSynapse(1.0);
+    Stdp reverse(rule, 0.1, 2);
+    reverse.index(r, 0, 2);
+    for (auto [step, neuron] : {std::pair{10u, 1}, std::pair{30u, 0}}) {
+        std::vector<int> fired{neuron};
+        reverse.apply(step, fired, r, 0, 2);
+        reverse.record(step, fired);
+    }
+    REQUIRE(r.weight(0) == Catch::Approx(1.0 - 0.2 * std::exp(-2.0 / 20.0)));
+    REQUIRE(reverse.postTrace(1, 30) == Catch::Approx(std::exp(-2.0 / 20.0)));
+    REQUIRE(reverse.preTrace(1, 100000) == 0.0);
+}
+
+TEST_CASE("STDP clamps weights and leaves other sources fixed") {
+    StdpRule rule;
+    rule.aPlus = 5.0;
+    rule.wMax = 2.0;
+
+    SynapseMatrix m(3);
+    m.append({Synapse(0, 2, 1.0), Synapse(1, 2, 1.0)});
+    Stdp stdp(rule, 0.1, 3);
+    stdp.index(m, 0, 1);
+    std::vector<int> pre{0, 1}, post{2};
+    stdp.apply(0, pre, m, 0, 3);
+    stdp.record(0, pre);
+    stdp.apply(1, post, m, 0, 3);
+    REQUIRE(m.weight(0) == 2.0);
+    REQUIRE(m.weight(1) == 1.0);
+}
+
+TEST_CASE("Event-driven STDP matches the all-pairs rule") {
+    StdpRule rule;
+    rule.aPlus = 0.002;
+    rule.aMinus = 0.0025;
+    rule.wMin = -100.0;
+    rule.wMax = 100.0;
+
+    Simulation sim(8, 8, 0.1, 3);
+    sim.connectRandom(0.2, 2.0, 0.5, 5);
+    sim.enableStdp(rule);
+    sim.setInputCurrent(18.0);
+    sim.run(1500);
+
+    std::map<int, std::vector<double>> times;
+    for (auto [t, neuron] : sim.spikeEvents()) times[neuron].push_back(t);
+    REQUIRE(times.size() > 10);
+
+    const SynapseMatrix& m = sim.connectivity();
+    for (int src = 0; src < sim.neuronCount(); ++src) {
+        for (std::size_t k = m.rowBegin(src); k < m.rowEnd(src); ++k) {
+            double expected = 2.0;
+            for (double tPre : times[src]) {
+                for (double tPost : times[m.target(k)]) {
+                    if (tPost > tPre) expected += rule.aPlus * std::exp(-(tPost - tPre) / rule.tauPlus);
+                    if (tPre > tPost) expected -= rule.aMinus * std::exp(-(tPre - tPost) / rule.tauMinus);
+                }
+            }
+            REQUIRE(m.weight(k) == Catch::Approx(expected).margin(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Plastic simulations are bit-identical for any thread count") {
+    auto run = [](int threads) {
+        Simulation sim(12, 12, 0.1, threads);
+        sim.connectByProximity(2.0, 1.5, 0.5);
+        sim.enableStdp(StdpRule{});
+        sim.setInputCurrent(18.0);
+        sim.run(800);
+        std::vector<double> weights;
+        for (std::size_t k = 0; k < sim.synapseCount(); ++k) {
+            weights.push_back(sim.connectivity().weight(k));
+        }
+        return std::make_pair(weights, sim.spikeEvents());
+    };
+
+    const auto reference = run(1);
+    REQUIRE_FALSE(reference.second.empty());
+    REQUIRE(std::any_of(reference.first.begin(), reference.first.end(),
+                        [](double w) { return w != 1.5; }));
+    for (int threads : {2, 4}) {
+        REQUIRE(run(threads) == reference);
+    }
+}
+
+TEST_CASE("STDP rejects non-positive time constants and decays slow traces past its table") {
+    StdpRule rule;
+    rule.tauPlus = 0.0;
+    REQUIRE_THROWS_AS(Stdp(rule, 0.1, 4), std::invalid_argument);
+    rule.tauPlus = 20.0;
+    rule.tauMinus = -5.0;
+    REQUIRE_THROWS_AS(Stdp(rule, 0.1, 4), std::invalid_argument);
+    rule.tauMinus = 20.0;
+    REQUIRE_THROWS_AS(Stdp(rule, 0.0, 4), std::invalid_argument);
+
+    Simulation sim(2, 2, 0.1);
+    rule.tauMinus = 0.0;
+    REQUIRE_THROWS_AS(sim.enableStdp(rule), std::invalid_argument);
+    REQUIRE(sim.stdp() == nullptr);
+
+    rule.tauPlus = 1e4;
+    rule.tauMinus = 20.0;
+    Stdp slow(rule, 0.1, 4);
+    slow.record(0, {1});
+    REQUIRE(slow.preTrace(1, 100) == std::exp(-100 * (0.1 / 1e4)));
+    REQUIRE(slow.preTrace(1, 100000) == Catch::Approx(std::exp(-1.0)));
+    REQUIRE(slow.postTrace(1, 100000) == 0.0);
+}
+
+TEST_CASE("STDP rejects inverted weight bounds") {
+    StdpRule rule;
+    rule.wMin = 5.0;
+    rule.wMax = 1.0;
+    REQUIRE_THROWS_AS(Stdp(rule, 0.1, 4), std::invalid_argument);
+
+    Simulation sim(2, 2, 0.1);
+    REQUIRE_THROWS_AS(sim.enableStdp(rule), std::invalid_argument);
+    REQUIRE(sim.stdp() == nullptr);
+
+    rule.wMax = 5.0;
+    REQUIRE_NOTHROW(Stdp(rule, 0.1, 4));
+}
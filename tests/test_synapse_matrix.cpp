@@ -0,0 +1,409 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "SynapseMatrix.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using Catch::Approx;
+
+TEST_CASE("SynapseMatrix groups synapses by source, sorted by target", "[SynapseMatrix]") {
+    SynapseMatrix m(3);
+    m.append({Synapse(2, 1, 3.0), Synapse(0, 2, 4.0), Synapse(2, 0, 1.0)});
+    m.append({Synapse(0, 1, 2.0)});
+
+    REQUIRE(m.synapseCount() == 4);
+    REQUIRE(m.rowEnd(0) - m.rowBegin(0) == 2);
+    REQUIRE(m.rowEnd(1) - m.rowBegin(1) == 0);
+    REQUIRE(m.target(m.rowBegin(0)) == 1);
+    REQUIRE(m.target(m.rowBegin(0) + 1) == 2);
+    REQUIRE(m.weight(m.rowBegin(2)) == Approx(1.0));
+    REQUIRE(m.weight(m.rowBegin(2) + 1) == Approx(3.0));
+}
+
+TEST_CASE("SynapseMatrix delivers only rows of spiking neurons", "[SynapseMatrix]") {
+    NeuronPopulation pop(NeuronPopulation::Model::IntegrateAndFire, 3);
+    SynapseMatrix m(3);
+    m.append({Synapse(0, 2, 5.0), Synapse(1, 2, 100.0)});
+
+    m.deliver({0}, pop);
+    pop.update(1.0, 0.0, 0, pop.size());
+
+    REQUIRE(pop.voltage(2) == Approx(-65.0 + 5.0 / 20.0));
+}
+
+TEST_CASE("SynapseMatrix keeps parallel synapses in insertion order", "[SynapseMatrix]") {
+    SynapseMatrix m(2);
+    m.append({Synapse(0, 1, 1.0), Synapse(0, 0, 7.0), Synapse(0, 1, 2.0)});
+    m.append({Synapse(0, 1, 3.0)});
+
+    REQUIRE(m.target(0) == 0);
+    REQUIRE(m.weight(1) == Approx(1.0));
+    REQUIRE(m.weight(2) == Approx(2.0));
+    REQUIRE(m.weight(3) == Approx(3.0));
+}
+
+TEST_CASE("SynapseMatrix delivers to a restricted target range", "[SynapseMatrix]") {
+    NeuronPopulation pop(NeuronPopulation::Model::IntegrateAndFire, 4);
+    SynapseMatrix m(4);
+    m.append({Synapse(0, 1, 5.0), Synapse(0, 2, 5.0), Synapse(0, 3, 5.0)});
+
+    m.deliver({0}, pop, 2, 3);
+    pop.update(1.0, 0.0, 0, pop.size());
+
+    REQUIRE(pop.voltage(1) == Approx(-65.0));
+    REQUIRE(pop.voltage(2) > -65.0);
+    REQUIRE(pop.voltage(3) == Approx(-65.0));
+}
+
+TEST_CASE("Simulation CSR delivery matches per-synapse propagation", "[SynapseMatrix]") {
+    Simulation sim(4, 4);
+    sim.connectByProximity(1.5, 2.0);
+    sim.setInputCurrent(30.0);
+
+    NeuronPopulation ref(NeuronPopulation::Model::IntegrateAndFire, 16);
+    std::vector<Synapse> synapses;
+    for (int src = 0; src < 16; ++src) {
+        const auto& c = sim.connectivity();
+        for (std::size_t k = c.rowBegin(src); k < c.rowEnd(src); ++k) {
+            synapses.emplace_back(src, c.target(k), c.weight(k));
+        }
+    }
+
+    for (int s = 0; s < 300; ++s) {
+        sim.step();
+        ref.update(0.1, 30.0, 0, ref.size());
+        for (const auto& syn : synapses) syn.propagate(ref);
+        for (int i = 0; i < 16; ++i) {
+            REQUIRE(sim.population().voltage(i) == ref.voltage(i));
+        }
+    }
+    REQUIRE(sim.synapseCount() == synapses.size());
+}
+
+TEST_CASE("SynapseMatrix delays delivery through the input ring", "[SynapseMatrix]") {
+    NeuronPopulation pop(NeuronPopulation::Model::IntegrateAndFire, 2);
+    SynapseMatrix m(2);
+    m.append({Synapse(0, 1, 10.0, 3)});
+    REQUIRE(m.maxDelay() == 3);
+    pop.setDelaySlots(m.maxDelay());
+
+    std::vector<double> v;
+    for (int step = 0; step < 5; ++step) {
+        pop.update(0.1, 0.0, 0, pop.size());
+        v.push_back(pop.voltage(1));
+        m.deliver(step == 0 ? std::vector<int>{0} : std::vector<int>{}, pop);
+        pop.advanceDelaySlot();
+    }
+
+    REQUIRE(v[1] == Approx(-65.0));
+    REQUIRE(v[2] == Approx(-65.0));
+    REQUIRE(v[3] > -65.0);
+}
+
+TEST_CASE("Simulation converts delays to steps and grows the input ring", "[SynapseMatrix]") {
+    Simulation sim(3, 1, 0.1);
+    sim.connectByProximity(2.0, 1.0, 0.2, 0.5);
+
+    REQUIRE(sim.connectivity().maxDelay() == 12);
+    REQUIRE(sim.population().delaySlots() == 12);
+    const auto& c = sim.connectivity();
+    for (std::size_t k = c.rowBegin(0); k < c.rowEnd(0); ++k) {
+        REQUIRE(c.delay(k) == (c.target(k) == 1 ? 7 : 12));
+    }
+}
+
+TEST_CASE("SynapseMatrix merges row-ordered synapses behind existing ones", "[SynapseMatrix]") {
+    SynapseMatrix m(3);
+    m.append({Synapse(0, 2, 1.0), Synapse(1, 0, 2.0)});
+
+    SynapseRows rows;
+    rows.offsets = {0, 2, 2, 3};
+    rows.targets = {1, 2, 0};
+    rows.weights = {3.0, 4.0, 5.0};
+    rows.delays = {1, 4, 1};
+    m.append(rows);
+
+    REQUIRE(m.synapseCount() == 5);
+    REQUIRE(m.maxDelay() == 4);
+    REQUIRE(m.rowEnd(0) - m.rowBegin(0) == 3);
+    REQUIRE(m.target(0) == 1);
+    REQUIRE(m.weight(1) == 1.0);  // existing synapse to 2 first
+    REQUIRE(m.weight(2) == 4.0);
+    REQUIRE(m.delay(2) == 4);
+    REQUIRE(m.rowEnd(1) - m.rowBegin(1) == 1);
+    REQUIRE(m.weight(m.rowBegin(2)) == 5.0);
+}
+
+TEST_CASE("Stencil proximity connections match the all-pairs definition", "[SynapseMatrix]") {
+    const int nx = 7, ny = 5;
+    const double radius = 2.3;
+    Simulation sim(nx, ny, 0.1, 3);
+    sim.connectByProximity(radius, 1.5, 0.1, 0.4);
+
+    const auto& c = sim.connectivity();
+    std::size_t expected = 0;
+    for (int i = 0; i < nx * ny; ++i) {
+        std::size_t k = c.rowBegin(i);
+        for (int j = 0; j < nx * ny; ++j) {
+            double dx = i % nx - j % nx, dy = i / nx - j / nx;
+            double distance = std::sqrt(dx * dx + dy * dy);
+            if (i == j || distance > radius) continue;
+            ++expected;
+            REQUIRE(k < c.rowEnd(i));
+            REQUIRE(c.target(k) == j);
+            REQUIRE(c.weight(k) == 1.5);
+            REQUIRE(c.delay(k) == std::lround((0.1 + distance * 0.4) / 0.1));
+            ++k;
+        }
+        REQUIRE(k == c.rowEnd(i));
+    }
+    REQUIRE(sim.synapseCount() == expected);
+}
+
+TEST_CASE("Proximity connections reject negative or NaN radii", "[SynapseMatrix]") {
+    Simulation sim(4, 4, 0.1);
+    sim.connectByProximity(1.5, 1.0);
+    const std::size_t count = sim.synapseCount();
+
+    REQUIRE_THROWS_AS(sim.connectByProximity(-1.0, 1.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(sim.connectByProximity(std::nan(""), 1.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(sim.connectByProximity(-1e300, 1.0), std::invalid_argument);
+    REQUIRE(sim.synapseCount() == count);
+
+    sim.connectByProximity(HUGE_VAL, 1.0);
+    REQUIRE(sim.synapseCount() == count + 16 * 15);
+}
+
+TEST_CASE("Toroidal proximity connections give every neuron the full stencil", "[SynapseMatrix]") {
+    Simulation sim(6, 4, 0.1, 2);
+    sim.connectByProximity(1.5, 1.0, 0.0, 0.0, true);
+
+    const auto& c = sim.connectivity();
+    for (int i = 0; i < 24; ++i) {
+        REQUIRE(c.rowEnd(i) - c.rowBegin(i) == 8);
+        for (std::size_t k = c.rowBegin(i); k < c.rowEnd(i); ++k) {
+            REQUIRE(c.target(k) != i);
+            if (k > c.rowBegin(i)) REQUIRE(c.target(k - 1) < c.target(k));
+        }
+    }
+    // Neuron 0 reaches across both edges.
+    REQUIRE(c.target(c.rowEnd(0) - 1) == 23);
+}
+
+TEST_CASE("Seeded random connections are reproducible at any thread count", "[SynapseMatrix]") {
+    Simulation a(30, 20, 0.1, 1), b(30, 20, 0.1, 4), c(30, 20, 0.1, 1);
+    a.connectRandom(0.05, 1.0, 0.0, 42);
+    b.connectRandom(0.05, 1.0, 0.0, 42);
+    c.connectRandom(0.05, 1.0, 0.0, 43);
+
+    const auto& ca = a.connectivity();
+    const auto& cb = b.connectivity();
+    REQUIRE(ca.synapseCount() == cb.synapseCount());
+    REQUIRE(ca.synapseCount() != c.connectivity().synapseCount());
+    for (int i = 0; i < 600; ++i) {
+        REQUIRE(ca.rowBegin(i) == cb.rowBegin(i));
+        for (std::size_t k = ca.rowBegin(i); k < ca.rowEnd(i); ++k) {
+            REQUIRE(ca.target(k) == cb.target(k));
+            REQUIRE(ca.target(k) != i);
+        }
+    }
+
+    // 600 × 599 candidate pairs at p = 0.05: mean 17970, sd ≈ 134.
+    REQUIRE(ca.synapseCount() > 17970 - 700);
+    REQUIRE(ca.synapseCount() < 17970 + 700);
+}
+
+TEST_CASE("Random connections with p = 1 connect all distinct pairs", "[SynapseMatrix]") {
+    Simulation sim(4, 3);
+    sim.connectRandom(1.0, 1.0, 0.0, 7);
+    REQUIRE(sim.synapseCount() == 12 * 11);
+}
+
+TEST_CASE("Varint target encoding round-trips rows with any gap", "[SynapseMatrix]") {
+    const int n = 3'000'000;
+    SynapseMatrix m(n);
+    m.append({Synapse(0, 5, 1.0), Synapse(0, 5, 2.0), Synapse(0, 200, 3.0),
+              Synapse(0, 20'000, 4.0), Synapse(0, n - 1, 5.0), Synapse(2, 0, 6.0)});
+    m.setTargetEncoding(SynapseMatrix::TargetEncoding::Varint);
+    m.append({Synapse(2, 1, 7.0), Synapse(0, 6, 8.0)});
+
+    REQUIRE(m.targetEncoding() == SynapseMatrix::TargetEncoding::Varint);
+    const std::vector<int> expected{5, 5, 6, 200, 20'000, n - 1, 0, 1};
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+        REQUIRE(m.target(k) == expected[k]);
+    }
+    REQUIRE(m.weight(2) == 8.0);
+
+    std::vector<int> visited;
+    m.forEachInRow(0, 6, 20'001, [&](std::size_t k, int target) {
+        REQUIRE(target == m.target(k));
+        visited.push_back(target);
+    });
+    REQUIRE(visited == std::vector<int>{6, 200, 20'000});
+
+    m.setTargetEncoding(SynapseMatrix::TargetEncoding::Plain);
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+        REQUIRE(m.target(k) == expected[k]);
+    }
+}
+
+TEST_CASE("Varint rows are visited from any target onward", "[SynapseMatrix]") {
+    SynapseMatrix plain(1000), packed(1000);
+    std::vector<Synapse> synapses;
+    for (int j = 0; j < 1000; j += 3) synapses.emplace_back(j % 2, j, 1.0);
+    plain.append(synapses);
+    packed.setTargetEncoding(SynapseMatrix::TargetEncoding::Varint);
+    packed.append(synapses);
+
+    auto visit = [](const SynapseMatrix& m, int src, int begin, int end) {
+        std::vector<std::pair<std::size_t, int>> visited;
+        m.forEachInRow(src, begin, end, [&](std::size_t k, int t) { visited.emplace_back(k, t); });
+        return visited;
+    };
+    for (int src : {0, 1}) {
+        for (int begin : {1, 200, 201, 500, 999}) {
+            REQUIRE(visit(packed, src, begin, begin + 300) == visit(plain, src, begin, begin + 300));
+        }
+    }
+}
+
+TEST_CASE("Varint targets shrink the connectivity without changing the dynamics", "[SynapseMatrix]") {
+    auto run = [](SynapseMatrix::TargetEncoding encoding, int threads) {
+        Simulation sim(20, 20, 0.1, threads);
+        sim.setTargetEncoding(encoding);
+        sim.connectByProximity(2.5, 1.5, 0.5, 0.2);
+        sim.connectRandom(0.05, 0.8, 1.0, 11);
+        sim.setInputCurrent(18.0);
+        sim.run(500);
+        return std::make_pair(sim.spikeEvents(), sim.connectivity().bytesPerSynapse());
+    };
+
+    const auto plain = run(SynapseMatrix::TargetEncoding::Plain, 1);
+    REQUIRE_FALSE(plain.first.empty());
+    for (int threads : {1, 3}) {
+        const auto packed = run(SynapseMatrix::TargetEncoding::Varint, threads);
+        REQUIRE(packed.first == plain.first);
+        REQUIRE(packed.second < plain.second - 2.5);
+    }
+}
+
+TEST_CASE("Quantized weights decode with bounded error", "[SynapseMatrix]") {
+    const std::vector<double> weights{1.0, 0.1, -2.5, 65504.0, 1e-7, 3.0};
+    auto build = [&](SynapseMatrix::WeightEncoding encoding) {
+        SynapseMatrix m(2);
+        m.setWeightEncoding(encoding);
+        std::vector<Synapse> synapses;
+        for (std::size_t k = 0; k < weights.size(); ++k) {
+            synapses.emplace_back(k < 5 ? 0 : 1, static_cast<int>(k % 2), weights[k]);
+        }
+        m.append(synapses);
+        return m;
+    };
+
+    SynapseMatrix half = build(SynapseMatrix::WeightEncoding::Half);
+    std::vector<double> decoded;
+    half.forEachWeighted(0, [&](std::size_t, int, double w) { decoded.push_back(w); });
+    // Row 0 sorted by target: weights 1.0, -2.5, 1e-7 (target 0), then 0.1, 65504 (target 1).
+    REQUIRE(decoded == std::vector<double>{1.0, -2.5, 2.0 * 0x1p-24, 0.0999755859375, 65504.0});
+    REQUIRE(half.weightError().maxAbs == Approx(0.1 - 0.0999755859375));
+
+    SynapseMatrix int8 = build(SynapseMatrix::WeightEncoding::Int8);
+    const double step = 65504.0 / 127.0;
+    REQUIRE(int8.weight(1) == Approx(-2.5).margin(step / 2));
+    REQUIRE(int8.weight(int8.rowBegin(1)) == 3.0);  // a row's largest weight is exact
+    REQUIRE(int8.weightError().maxAbs <= step / 2);
+    REQUIRE(int8.weightError().rms > 0.0);
+
+    SynapseMatrix shared = build(SynapseMatrix::WeightEncoding::Shared);
+    for (std::size_t k = 0; k < shared.synapseCount(); ++k) {
+        REQUIRE(shared.weight(k) == build(SynapseMatrix::WeightEncoding::Double).weight(k));
+    }
+    REQUIRE(shared.weightError().maxAbs == 0.0);
+
+    std::vector<Synapse> distinct;
+    for (int k = 0; k < 260; ++k) distinct.emplace_back(1, 0, 0.01 * k);
+    REQUIRE_THROWS_AS(shared.append(distinct), std::invalid_argument);
+    REQUIRE(shared.synapseCount() == weights.size());
+}
+
+TEST_CASE("Quantized weights shrink delivery state and keep exact dynamics", "[SynapseMatrix]") {
+    auto run = [](SynapseMatrix::WeightEncoding encoding) {
+        Simulation sim(20, 20, 0.1, 2);
+        sim.setWeightEncoding(encoding);
+        sim.connectByProximity(2.5, 1.5, 0.5, 0.2);
+        sim.connectRandom(0.05, -0.75, 1.0, 11);
+        sim.setInputCurrent(18.0);
+        sim.run(500);
+        REQUIRE(sim.connectivity().weightError().maxAbs == 0.0);
+        return std::make_pair(sim.spikeEvents(), sim.connectivity().bytesPerSynapse());
+    };
+
+    // Both constants are exact in every encoding and rows hold at most two values.
+    const auto reference = run(SynapseMatrix::WeightEncoding::Double);
+    REQUIRE_FALSE(reference.first.empty());
+    for (auto encoding : {SynapseMatrix::WeightEncoding::Shared, SynapseMatrix::WeightEncoding::Half}) {
+        const auto quantized = run(encoding);
+        REQUIRE(quantized.first == reference.first);
+        REQUIRE(quantized.second <= reference.second - 6.0);
+    }
+
+    Simulation plastic(4, 4);
+    plastic.setWeightEncoding(SynapseMatrix::WeightEncoding::Half);
+    REQUIRE_THROWS_AS(plastic.enableStdp(StdpRule{}), std::logic_error);
+    plastic.setWeightEncoding(SynapseMatrix::WeightEncoding::Double);
+    plastic.enableStdp(StdpRule{});
+    REQUIRE_THROWS_AS(plastic.setWeightEncoding(SynapseMatrix::WeightEncoding::Int8), std::logic_error);
+}
+
+TEST_CASE("Procedural random connectivity matches the stored build", "[SynapseMatrix]") {
+    auto run = [](bool procedural, int threads) {
+        Simulation sim(20, 20, 0.1, threads);
+        sim.setPopulations({{"exc", nullptr, 320, {}, 0, 1}, {"inh", nullptr, 80, {}, 0, 1}});
+        sim.setProceduralConnectivity(procedural);
+        sim.connectRandom(0.05, 1.2, 0.5, 21, "exc");
+        sim.connectRandom(0.2, -2.0, 1.0, 22, "inh", "exc");
+        sim.connectByProximity(1.5, 0.4, 0.3);
+        sim.setInputCurrent(18.0);
+        sim.run(600);
+        return std::make_tuple(sim.spikeEvents(), sim.synapseCount(),
+                               sim.connectivity().bytesPerSynapse());
+    };
+
+    const auto stored = run(false, 1);
+    REQUIRE(std::get<0>(stored).size() > 100);
+    for (int threads : {1, 3}) {
+        const auto procedural = run(true, threads);
+        REQUIRE(std::get<0>(procedural) == std::get<0>(stored));
+        REQUIRE(std::get<1>(procedural) == std::get<1>(stored));
+        REQUIRE(std::get<2>(procedural) < std::get<2>(stored) / 2.0);
+    }
+
+    Simulation plastic(4, 4);
+    plastic.setProceduralConnectivity(true);
+    plastic.connectRandom(0.5, 1.0, 0.0, 1);
+    REQUIRE(plastic.synapseCount() > 0);
+    REQUIRE(plastic.connectivity().synapseCount() == 0);
+    REQUIRE_THROWS_AS(plastic.enableStdp(StdpRule{}), std::logic_error);
+}
+
+TEST_CASE("Procedural rows can be regenerated in target ranges", "[SynapseMatrix]") {
+    const RandomProjection projection(7, 0.05, 1.0, 1, 0, 5000, 0, 5000);
+    std::size_t total = 0;
+    for (int src : {0, 1234, 4999}) {
+        std::vector<int> whole, pieces;
+        projection.forEachTarget(src, [&](int t) { whole.push_back(t); });
+        for (int first = 0; first < 5000; first += 700) {
+            projection.forEachTarget(src, first, first + 700, [&](int t) { pieces.push_back(t); });
+        }
+        REQUIRE(pieces == whole);
+        REQUIRE(std::is_sorted(whole.begin(), whole.end()));
+        REQUIRE(std::find(whole.begin(), whole.end(), src) == whole.end());
+        total += whole.size();
+    }
+    REQUIRE(total > 3 * 200);
+    REQUIRE(total < 3 * 300);
+}
@@ -0,0 +1,35 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ThreadPool.h"
+#include <atomic>
+
+TEST_CASE("ThreadPool runs the task once on every worker") {
+    ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    for (int round = 0; round < 100; ++round) {
+        std::vector<int> hits(pool.size(), 0);
+        pool.run([&](int w) { ++hits[w]; });
+        for (int h : hits) {
+            REQUIRE(h == 1);
+        }
+    }
+}
+
+TEST_CASE("ThreadPool of size one runs inline") {
+    ThreadPool pool(1);
+    int calls = 0;
+    pool.run([&](int w) { calls += 1 + w; });
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("ThreadPool::split covers the range with aligned chunks") {
+    const std::size_t n = 1000;
+    std::size_t expected = 0;
+    for (int part = 0; part < 7; ++part) {
+        auto [begin, end] = ThreadPool::split(n, 7, part, 64);
+        REQUIRE(begin == expected);
+        REQUIRE((begin % 64 == 0 || begin == n));
+        expected = end;
+    }
+    REQUIRE(expected == n);
+}